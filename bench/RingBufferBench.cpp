@@ -0,0 +1,616 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "CopyFunction.h"
+#include "Crc32c.h"
+#include "MpmcRingBuffer.h"
+#include "PowerOfTwoRingBuffer.h"
+#include "RingBuffer.h"
+#include "RingBufferStorage.h"
+#include "SpscRingBuffer.h"
+#include "TypedRingBuffer.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+// Buffer sizes are powers of two so that every variant can run with the same
+// arguments.
+const int64_t MIN_BUFFER_SIZE = 4 << 10;
+const int64_t MAX_BUFFER_SIZE = 1 << 20;
+const int64_t MIN_MESSAGE_SIZE = 1;
+const int64_t MAX_MESSAGE_SIZE = 64 << 10;
+
+/**
+ * Registers every (buffer size, message size) combination in which the
+ * message fits in the buffer.
+ */
+void bufferAndMessageSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgNames({"buffer", "message"});
+    for (auto buffer = MIN_BUFFER_SIZE; buffer <= MAX_BUFFER_SIZE;
+         buffer *= 16) {
+        for (auto message = MIN_MESSAGE_SIZE;
+             message <= MAX_MESSAGE_SIZE && message <= buffer; message *= 4) {
+            benchmark->Args({buffer, message});
+        }
+    }
+}
+
+/**
+ * Registers buffer sizes for the wrap-heavy benchmarks.
+ */
+void bufferSizes(benchmark::internal::Benchmark *benchmark) {
+    benchmark->ArgNames({"buffer"});
+    for (auto buffer = MIN_BUFFER_SIZE; buffer <= MAX_BUFFER_SIZE;
+         buffer *= 16) {
+        benchmark->Args({buffer});
+    }
+}
+
+/**
+ * Reports throughput and per-operation counters.
+ */
+void setCounters(benchmark::State &state, size_t message) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(message));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+/**
+ * Writes and then reads one message per iteration.
+ */
+template <class Ring> void BM_WriteRead(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size);
+    vector<char> source(message, 'x');
+    vector<char> destination(message);
+    Ring ring(buffer.data(), size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.writeBytes(source.data(), message));
+        benchmark::DoNotOptimize(ring.readBytes(destination.data(), message));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Writes and then reads one message of just over half the buffer per
+ * iteration, so that nearly every operation wraps around the end of the
+ * buffer.
+ */
+template <class Ring> void BM_WriteReadWrapHeavy(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = size / 2 + 1;
+    vector<char> buffer(size);
+    vector<char> source(message, 'x');
+    vector<char> destination(message);
+    Ring ring(buffer.data(), size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.writeBytes(source.data(), message));
+        benchmark::DoNotOptimize(ring.readBytes(destination.data(), message));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Writes one message per iteration, emptying the ring buffer whenever it
+ * fills up.
+ */
+template <class Ring> void BM_WriteBytes(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size);
+    vector<char> source(message, 'x');
+    Ring ring(buffer.data(), size);
+
+    for (auto _ : state) {
+        if (ring.getWritableByteCount() < message) {
+            ring.clear();
+        }
+        benchmark::DoNotOptimize(ring.writeBytes(source.data(), message));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Overwrites one message per iteration into a ring buffer that is always
+ * full, so that every write first drops the oldest bytes.
+ */
+void BM_OverwriteBytes(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size);
+    vector<char> source(message, 'x');
+    RingBuffer ring(buffer.data(), size);
+    ring.commitWrite(size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.overwriteBytes(source.data(), message));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Reads one message per iteration, refilling the ring buffer without copying
+ * whenever it runs low.
+ */
+template <class Ring> void BM_ReadBytes(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size, 'x');
+    vector<char> destination(message);
+    Ring ring(buffer.data(), size);
+
+    for (auto _ : state) {
+        if (ring.getReadableByteCount() < message) {
+            ring.commitWrite(ring.getWritableByteCount());
+        }
+        benchmark::DoNotOptimize(ring.readBytes(destination.data(), message));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Peeks one message per iteration at offsets that walk through a full ring
+ * buffer.
+ */
+template <class Ring> void BM_PeekBytesAt(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size, 'x');
+    vector<char> destination(message);
+    Ring ring(buffer.data(), size);
+    // Start a quarter of the way into the buffer so that the data wraps
+    // around.
+    ring.commitWrite(size / 2);
+    ring.consume(size / 4);
+    ring.commitWrite(ring.getWritableByteCount());
+
+    size_t where = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            ring.peekBytesAt(destination.data(), message, where));
+        benchmark::ClobberMemory();
+        where += message;
+        if (where + message > size) {
+            where = 0;
+        }
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Writes a multi-megabyte chunk into a ring buffer twice its size and reads it
+ * back out, copying with @p copy.
+ */
+void BM_BulkTransfer(benchmark::State &state, CopyFunction copy) {
+    auto chunk = static_cast<size_t>(state.range(0));
+    vector<char> buffer(2 * chunk);
+    vector<char> source(chunk, 'x');
+    vector<char> destination(chunk);
+    RingBuffer ring(buffer.data(), buffer.size());
+    ring.setCopyFunction(copy);
+
+    for (auto _ : state) {
+        ring.writeBytes(source.data(), chunk);
+        ring.readBytes(destination.data(), chunk);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, chunk);
+}
+
+/**
+ * Fills a freshly mapped ring buffer once, so that base pages that are not
+ * prefaulted take their first-touch faults inside the timed region.
+ */
+void BM_FirstFill(benchmark::State &state, unsigned flags) {
+    auto size = static_cast<size_t>(state.range(0));
+    vector<char> source(size, 'x');
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        RingBufferStorage storage(size, flags);
+        RingBuffer ring(storage.getBuffer(), storage.getSize());
+        state.ResumeTiming();
+        ring.writeBytes(source.data(), size);
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, size);
+}
+
+/**
+ * Finds a newline at the end of a full ring buffer whose data wraps around.
+ */
+void BM_FindByte(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    vector<char> buffer(size, 'x');
+    RingBuffer ring(buffer.data(), size);
+    ring.commitWrite(size / 2);
+    ring.consume(size / 4);
+    ring.commitWrite(ring.getWritableByteCount());
+    buffer[size / 4 - 1] = '\n';
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.findByte('\n'));
+    }
+    setCounters(state, size);
+}
+
+/**
+ * Does the same with a copy into a scratch buffer followed by memchr(), for
+ * comparison.
+ */
+void BM_FindBytePeekMemchr(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    vector<char> buffer(size, 'x');
+    vector<char> scratch(size);
+    RingBuffer ring(buffer.data(), size);
+    ring.commitWrite(size / 2);
+    ring.consume(size / 4);
+    ring.commitWrite(ring.getWritableByteCount());
+    buffer[size / 4 - 1] = '\n';
+
+    for (auto _ : state) {
+        auto n = ring.peekBytes(scratch.data(), size);
+        benchmark::DoNotOptimize(memchr(scratch.data(), '\n', n));
+    }
+    setCounters(state, size);
+}
+
+/**
+ * Peeks a full ring buffer whose data wraps around, checksumming the bytes in
+ * the same pass as the copy.
+ */
+void BM_PeekCrc32c(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    vector<char> buffer(size, 'x');
+    vector<char> scratch(size);
+    RingBuffer ring(buffer.data(), size);
+    ring.commitWrite(size / 2);
+    ring.consume(size / 4);
+    ring.commitWrite(ring.getWritableByteCount());
+
+    for (auto _ : state) {
+        uint32_t crc = 0;
+        ring.peekBytes(scratch.data(), size, crc);
+        benchmark::DoNotOptimize(crc);
+    }
+    setCounters(state, size);
+}
+
+/**
+ * Does the same with a plain copy followed by a second pass for the checksum,
+ * for comparison.
+ */
+void BM_PeekThenCrc32c(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    vector<char> buffer(size, 'x');
+    vector<char> scratch(size);
+    RingBuffer ring(buffer.data(), size);
+    ring.commitWrite(size / 2);
+    ring.consume(size / 4);
+    ring.commitWrite(ring.getWritableByteCount());
+
+    for (auto _ : state) {
+        auto n = ring.peekBytes(scratch.data(), size);
+        benchmark::DoNotOptimize(crc32c(scratch.data(), n));
+    }
+    setCounters(state, size);
+}
+
+/**
+ * Discards one message per iteration, refilling the ring buffer without
+ * copying whenever it runs low.
+ */
+template <class Ring> void BM_DiscardBytes(benchmark::State &state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto message = static_cast<size_t>(state.range(1));
+    vector<char> buffer(size);
+    Ring ring(buffer.data(), size);
+
+    for (auto _ : state) {
+        if (ring.getReadableByteCount() < message) {
+            ring.commitWrite(ring.getWritableByteCount());
+        }
+        benchmark::DoNotOptimize(ring.discardBytes(message));
+    }
+    setCounters(state, message);
+}
+
+/**
+ * Moves bytes one at a time through a small fixed-size ring buffer, as an
+ * interrupt handler feeding a task does. Builds with RINGBUFFER_HEADER_ONLY
+ * inline the whole pipeline.
+ */
+void BM_BytePipeline(benchmark::State &state) {
+    static char buffer[64];
+    RingBuffer ring(buffer);
+    char byte = 'x';
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < 48; ++i) {
+            ring.writeBytes(&byte, 1);
+        }
+        for (size_t i = 0; i < 48; ++i) {
+            ring.readBytes(&byte, 1);
+        }
+        benchmark::DoNotOptimize(byte);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * 48);
+}
+
+const size_t BATCH_MESSAGES = 32;
+
+/**
+ * Writes and then reads a burst of small messages per iteration, one call per
+ * message.
+ */
+template <class Ring> void BM_BurstSingle(benchmark::State &state) {
+    auto message = static_cast<size_t>(state.range(0));
+    vector<char> buffer(64 << 10);
+    vector<char> source(message * BATCH_MESSAGES, 'x');
+    vector<char> destination(message * BATCH_MESSAGES);
+    Ring ring(buffer.data(), buffer.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+            ring.writeBytes(source.data() + i * message, message);
+        }
+        for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+            ring.readBytes(destination.data() + i * message, message);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(BATCH_MESSAGES));
+    state.SetBytesProcessed(state.items_processed() *
+                            static_cast<int64_t>(message));
+}
+
+/**
+ * Writes and then reads a burst of small messages per iteration, one batch
+ * call per burst.
+ */
+template <class Ring> void BM_BurstBatch(benchmark::State &state) {
+    auto message = static_cast<size_t>(state.range(0));
+    vector<char> buffer(64 << 10);
+    vector<char> source(message * BATCH_MESSAGES, 'x');
+    vector<char> destination(message * BATCH_MESSAGES);
+    Ring ring(buffer.data(), buffer.size());
+    ConstSpan messages[BATCH_MESSAGES];
+    Span destinations[BATCH_MESSAGES];
+    for (size_t i = 0; i < BATCH_MESSAGES; ++i) {
+        messages[i].data = source.data() + i * message;
+        messages[i].size = message;
+        destinations[i].data = destination.data() + i * message;
+        destinations[i].size = message;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.writeBatch(messages, BATCH_MESSAGES));
+        benchmark::DoNotOptimize(ring.readBatch(destinations, BATCH_MESSAGES));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(BATCH_MESSAGES));
+    state.SetBytesProcessed(state.items_processed() *
+                            static_cast<int64_t>(message));
+}
+
+/**
+ * A 64-byte record, the size of a typical market-data message.
+ */
+struct Record {
+    uint64_t fields[8];
+};
+
+const size_t RECORD_CAPACITY = 1024;
+
+/**
+ * Writes and then reads one record per iteration through RingBuffer, which
+ * sees the record size only at run time.
+ */
+void BM_RecordBytes(benchmark::State &state) {
+    vector<Record> buffer(RECORD_CAPACITY);
+    RingBuffer ring(buffer.data(), RECORD_CAPACITY * sizeof(Record));
+    Record record = {};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.writeBytes(&record, sizeof(record)));
+        benchmark::DoNotOptimize(ring.readBytes(&record, sizeof(record)));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, sizeof(Record));
+}
+
+/**
+ * Writes and then reads one record per iteration through TypedRingBuffer.
+ */
+void BM_RecordTyped(benchmark::State &state) {
+    static Record buffer[RECORD_CAPACITY];
+    TypedRingBuffer<Record, RECORD_CAPACITY> ring(buffer);
+    Record record = {};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ring.write(record));
+        benchmark::DoNotOptimize(ring.read(record));
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, sizeof(Record));
+}
+
+/**
+ * A RingBuffer shared through a mutex, moving fixed-size messages with the
+ * same interface as MpmcRingBuffer.
+ */
+class LockedRingBuffer {
+public:
+    LockedRingBuffer(void *buffer, size_t size, size_t)
+        : _ring(buffer, size) {}
+
+    bool tryWrite(const void *message, size_t size) {
+        lock_guard<mutex> lock(_mutex);
+        if (_ring.getWritableByteCount() < size) {
+            return false;
+        }
+        _ring.writeBytes(message, size);
+        return true;
+    }
+
+    bool tryRead(void *destination, size_t capacity, size_t &size) {
+        lock_guard<mutex> lock(_mutex);
+        if (_ring.getReadableByteCount() < capacity) {
+            return false;
+        }
+        size = _ring.readBytes(destination, capacity);
+        return true;
+    }
+
+private:
+    mutex _mutex;
+    RingBuffer _ring;
+};
+
+const size_t CONTENDED_MESSAGE_SIZE = 64;
+const size_t CONTENDED_SLOT_COUNT = 1024;
+
+/**
+ * Has every thread write and then read one message per iteration through a
+ * shared ring buffer.
+ */
+template <class Ring> void BM_Contended(benchmark::State &state) {
+    // Placement new, since plain new does not honour the ring buffer's cache
+    // line alignment before C++17.
+    static typename aligned_storage<sizeof(Ring), alignof(Ring)>::type storage;
+    static vector<size_t> *buffer;
+    static Ring *ring;
+    if (state.thread_index() == 0) {
+        auto size = MpmcRingBuffer::getBufferSize(CONTENDED_SLOT_COUNT,
+                                                  CONTENDED_MESSAGE_SIZE);
+        buffer = new vector<size_t>(size / sizeof(size_t));
+        ring =
+            new (&storage) Ring(buffer->data(), size, CONTENDED_MESSAGE_SIZE);
+    }
+    char message[CONTENDED_MESSAGE_SIZE] = {};
+
+    for (auto _ : state) {
+        size_t size;
+        benchmark::DoNotOptimize(ring->tryWrite(message, sizeof(message)));
+        benchmark::DoNotOptimize(
+            ring->tryRead(message, sizeof(message), size));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+    if (state.thread_index() == 0) {
+        ring->~Ring();
+        delete buffer;
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_WriteRead, RingBuffer)->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_WriteRead, PowerOfTwoRingBuffer)
+    ->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_WriteRead, SpscRingBuffer)->Apply(bufferAndMessageSizes);
+
+BENCHMARK_TEMPLATE(BM_WriteReadWrapHeavy, RingBuffer)->Apply(bufferSizes);
+BENCHMARK_TEMPLATE(BM_WriteReadWrapHeavy, PowerOfTwoRingBuffer)
+    ->Apply(bufferSizes);
+BENCHMARK_TEMPLATE(BM_WriteReadWrapHeavy, SpscRingBuffer)->Apply(bufferSizes);
+
+BENCHMARK_TEMPLATE(BM_WriteBytes, RingBuffer)->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_WriteBytes, PowerOfTwoRingBuffer)
+    ->Apply(bufferAndMessageSizes);
+
+BENCHMARK(BM_OverwriteBytes)->Apply(bufferAndMessageSizes);
+
+BENCHMARK_TEMPLATE(BM_ReadBytes, RingBuffer)->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_ReadBytes, PowerOfTwoRingBuffer)
+    ->Apply(bufferAndMessageSizes);
+
+BENCHMARK_TEMPLATE(BM_PeekBytesAt, RingBuffer)->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_PeekBytesAt, PowerOfTwoRingBuffer)
+    ->Apply(bufferAndMessageSizes);
+
+BENCHMARK_TEMPLATE(BM_DiscardBytes, RingBuffer)->Apply(bufferAndMessageSizes);
+BENCHMARK_TEMPLATE(BM_DiscardBytes, PowerOfTwoRingBuffer)
+    ->Apply(bufferAndMessageSizes);
+
+BENCHMARK(BM_RecordBytes);
+BENCHMARK(BM_RecordTyped);
+
+BENCHMARK(BM_BytePipeline);
+
+BENCHMARK_TEMPLATE(BM_BurstSingle, RingBuffer)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_BurstBatch, RingBuffer)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_BurstSingle, SpscRingBuffer)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_BurstBatch, SpscRingBuffer)->Arg(16)->Arg(64);
+
+BENCHMARK_TEMPLATE(BM_Contended, LockedRingBuffer)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Contended, MpmcRingBuffer)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_FindByte)->Apply(bufferSizes);
+BENCHMARK(BM_FindBytePeekMemchr)->Apply(bufferSizes);
+
+BENCHMARK(BM_PeekCrc32c)->Apply(bufferSizes);
+BENCHMARK(BM_PeekThenCrc32c)->Apply(bufferSizes);
+
+BENCHMARK_CAPTURE(BM_BulkTransfer, memcpy, nullptr)
+    ->Arg(1 << 20)
+    ->Arg(16 << 20)
+    ->Arg(64 << 20);
+BENCHMARK_CAPTURE(BM_BulkTransfer, nonTemporal, nonTemporalCopy)
+    ->Arg(1 << 20)
+    ->Arg(16 << 20)
+    ->Arg(64 << 20);
+
+BENCHMARK_CAPTURE(BM_FirstFill, basePages, RingBufferStorage::NONE)
+    ->Arg(16 << 20)
+    ->Arg(64 << 20);
+BENCHMARK_CAPTURE(BM_FirstFill, hugePrefaulted,
+                  RingBufferStorage::HUGE_PAGES | RingBufferStorage::PREFAULT)
+    ->Arg(16 << 20)
+    ->Arg(64 << 20);
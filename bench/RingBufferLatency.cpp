@@ -0,0 +1,390 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Measures one-way latency and sustained throughput of timestamped messages
+// sent from a producer thread to a consumer thread through each ring buffer
+// variant.
+//
+// Usage:
+//   ringbufferlatency [--variant NAME|all] [--producer-core N]
+//                     [--consumer-core N] [--messages N] [--message-size N]
+//                     [--capacity N] [--rate N]
+//
+// --rate limits the producer to N messages per second. The default, 0, sends
+// as fast as possible, which measures latency under saturation (including
+// time spent queued in a full ring buffer).
+
+#include "MpmcRingBuffer.h"
+#include "RingBuffer.h"
+#include "SpscRingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+struct Options {
+    string variant = "all";
+    int producerCore = -1;
+    int consumerCore = -1;
+    size_t messages = 1000000;
+    size_t messageSize = 64;
+    size_t capacity = 64 << 10;
+    uint64_t rate = 0;
+};
+
+struct Result {
+    vector<int64_t> latencies;
+    double seconds;
+};
+
+/**
+ * Pins the calling thread to a core, if a core was requested.
+ */
+void pinToCore(int core) {
+    if (core < 0) {
+        return;
+    }
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        fprintf(stderr, "warning: could not pin thread to core %d\n", core);
+    }
+#else
+    fprintf(stderr, "warning: thread pinning not supported\n");
+#endif
+}
+
+/**
+ * Returns the current time in nanoseconds since the clock's epoch.
+ */
+int64_t now() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * Backs off after a failed attempt, yielding once the attempt count shows the
+ * other thread is probably not running.
+ */
+void backOff(unsigned &attempts) {
+    if (++attempts % 1024 == 0) {
+        this_thread::yield();
+    }
+}
+
+/**
+ * A RingBuffer shared through a mutex.
+ */
+class MutexChannel {
+public:
+    MutexChannel(void *buffer, size_t size, size_t) : _ring(buffer, size) {}
+
+    bool write(const void *source, size_t count) {
+        lock_guard<mutex> lock(_mutex);
+        if (_ring.getWritableByteCount() < count) {
+            return false;
+        }
+        _ring.writeBytes(source, count);
+        return true;
+    }
+
+    bool read(void *destination, size_t count) {
+        lock_guard<mutex> lock(_mutex);
+        if (_ring.getReadableByteCount() < count) {
+            return false;
+        }
+        _ring.readBytes(destination, count);
+        return true;
+    }
+
+private:
+    mutex _mutex;
+    RingBuffer _ring;
+};
+
+/**
+ * An SpscRingBuffer. Since each side is the only one adding or removing bytes,
+ * a count check followed by the transfer is all or nothing.
+ */
+class SpscChannel {
+public:
+    SpscChannel(void *buffer, size_t size, size_t) : _ring(buffer, size) {}
+
+    bool write(const void *source, size_t count) {
+        if (_ring.getWritableByteCount() < count) {
+            return false;
+        }
+        _ring.writeBytes(source, count);
+        return true;
+    }
+
+    bool read(void *destination, size_t count) {
+        if (_ring.getReadableByteCount() < count) {
+            return false;
+        }
+        _ring.readBytes(destination, count);
+        return true;
+    }
+
+private:
+    SpscRingBuffer _ring;
+};
+
+/**
+ * An SpscRingBuffer whose threads sleep instead of polling when they have to
+ * wait. A wait that times out may still transfer part of a message, so once
+ * any byte has moved, the rest follows before returning, which keeps the
+ * messages framed.
+ */
+class SpscWaitChannel {
+public:
+    SpscWaitChannel(void *buffer, size_t size, size_t)
+        : _ring(buffer, size) {}
+
+    bool write(const void *source, size_t count) {
+        auto bytes = static_cast<const char *>(source);
+        auto written = _ring.writeBytesWait(bytes, count, chrono::seconds(1));
+        if (written == 0) {
+            return false;
+        }
+        while (written < count) {
+            written += _ring.writeBytesWait(bytes + written, count - written,
+                                            chrono::seconds(1));
+        }
+        return true;
+    }
+
+    bool read(void *destination, size_t count) {
+        auto bytes = static_cast<char *>(destination);
+        auto read = _ring.readBytesWait(bytes, count, chrono::seconds(1));
+        if (read == 0) {
+            return false;
+        }
+        while (read < count) {
+            read += _ring.readBytesWait(bytes + read, count - read,
+                                        chrono::seconds(1));
+        }
+        return true;
+    }
+
+private:
+    SpscRingBuffer _ring;
+};
+
+/**
+ * An MpmcRingBuffer with one slot per message.
+ */
+class MpmcChannel {
+public:
+    MpmcChannel(void *buffer, size_t size, size_t messageSize)
+        : _ring(buffer, size, messageSize) {}
+
+    bool write(const void *source, size_t count) {
+        return _ring.tryWrite(source, count);
+    }
+
+    bool read(void *destination, size_t count) {
+        size_t size;
+        return _ring.tryRead(destination, count, size);
+    }
+
+private:
+    MpmcRingBuffer _ring;
+};
+
+/**
+ * Sends the messages through a channel and records each one's latency.
+ */
+template <class Channel> Result run(const Options &options) {
+    vector<char> buffer(options.capacity);
+    Channel channel(buffer.data(), buffer.size(), options.messageSize);
+    Result result;
+    result.latencies.resize(options.messages);
+    atomic<bool> ready(false);
+
+    thread producer([&] {
+        pinToCore(options.producerCore);
+        vector<char> message(options.messageSize, 'x');
+        auto interval = options.rate == 0
+                            ? 0
+                            : static_cast<int64_t>(1000000000 / options.rate);
+        while (!ready.load(memory_order_acquire)) {
+        }
+        auto next = now();
+        for (size_t i = 0; i < options.messages; ++i) {
+            if (interval != 0) {
+                while (now() < next) {
+                }
+                next += interval;
+            }
+            auto timestamp = now();
+            memcpy(message.data(), &timestamp, sizeof(timestamp));
+            unsigned attempts = 0;
+            while (!channel.write(message.data(), message.size())) {
+                backOff(attempts);
+            }
+        }
+    });
+
+    pinToCore(options.consumerCore);
+    vector<char> message(options.messageSize);
+    ready.store(true, memory_order_release);
+    auto start = Clock::now();
+    for (size_t i = 0; i < options.messages; ++i) {
+        unsigned attempts = 0;
+        while (!channel.read(message.data(), message.size())) {
+            backOff(attempts);
+        }
+        auto received = now();
+        int64_t timestamp;
+        memcpy(&timestamp, message.data(), sizeof(timestamp));
+        result.latencies[i] = received - timestamp;
+    }
+    result.seconds = chrono::duration<double>(Clock::now() - start).count();
+    producer.join();
+    return result;
+}
+
+/**
+ * Returns the value at a given percentile of sorted latencies.
+ */
+int64_t percentile(const vector<int64_t> &sorted, double p) {
+    auto index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void report(const char *name, const Options &options, Result result) {
+    sort(result.latencies.begin(), result.latencies.end());
+    auto messagesPerSecond = options.messages / result.seconds;
+    printf("%-9s %10lld %10lld %10lld %10lld %14.0f %10.1f\n", name,
+           static_cast<long long>(percentile(result.latencies, 50)),
+           static_cast<long long>(percentile(result.latencies, 99)),
+           static_cast<long long>(percentile(result.latencies, 99.9)),
+           static_cast<long long>(result.latencies.back()), messagesPerSecond,
+           messagesPerSecond * options.messageSize / 1e6);
+}
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--variant mutex|spsc|spsc-wait|mpmc|all]\n"
+            "       [--producer-core N] [--consumer-core N] [--messages N]\n"
+            "       [--message-size N] [--capacity N] [--rate N]\n",
+            program);
+    exit(2);
+}
+
+Options parse(int argc, char *argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        string name = argv[i];
+        const char *value = argv[++i];
+        if (name == "--variant") {
+            options.variant = value;
+        } else if (name == "--producer-core") {
+            options.producerCore = atoi(value);
+        } else if (name == "--consumer-core") {
+            options.consumerCore = atoi(value);
+        } else if (name == "--messages") {
+            options.messages = strtoull(value, nullptr, 0);
+        } else if (name == "--message-size") {
+            options.messageSize = strtoull(value, nullptr, 0);
+        } else if (name == "--capacity") {
+            options.capacity = strtoull(value, nullptr, 0);
+        } else if (name == "--rate") {
+            options.rate = strtoull(value, nullptr, 0);
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (options.messages == 0 || options.messageSize < sizeof(int64_t) ||
+        options.capacity <
+            MpmcRingBuffer::getBufferSize(1, options.messageSize)) {
+        fprintf(stderr, "error: need at least one message, messages of at "
+                        "least 8 bytes and a capacity of at least one "
+                        "message slot\n");
+        exit(2);
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    auto options = parse(argc, argv);
+
+    printf("%zu messages of %zu bytes, capacity %zu bytes, rate %s\n",
+           options.messages, options.messageSize, options.capacity,
+           options.rate == 0 ? "unlimited"
+                             : (to_string(options.rate) + "/s").c_str());
+    printf("%-9s %10s %10s %10s %10s %14s %10s\n", "variant", "p50 ns",
+           "p99 ns", "p99.9 ns", "max ns", "msg/s", "MB/s");
+
+    bool ran = false;
+    if (options.variant == "all" || options.variant == "mutex") {
+        report("mutex", options, run<MutexChannel>(options));
+        ran = true;
+    }
+    if (options.variant == "all" || options.variant == "spsc") {
+        report("spsc", options, run<SpscChannel>(options));
+        ran = true;
+    }
+    if (options.variant == "all" || options.variant == "spsc-wait") {
+        report("spsc-wait", options, run<SpscWaitChannel>(options));
+        ran = true;
+    }
+    if (options.variant == "all" || options.variant == "mpmc") {
+        report("mpmc", options, run<MpmcChannel>(options));
+        ran = true;
+    }
+    if (!ran) {
+        usage(argv[0]);
+    }
+    return 0;
+}
@@ -0,0 +1,371 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+// Measures the sustained throughput of each ring buffer variant and, given a
+// baseline, fails when any of them has dropped by more than a tolerance. CTest
+// runs it as RingBufferThroughputGate when RINGBUFFER_THROUGHPUT_GATE is on.
+//
+// Usage:
+//   ringbufferthroughput [--baseline FILE] [--tolerance FRACTION]
+//                        [--record FILE] [--seconds S]
+//
+// Each workload runs three times for --seconds (default 0.2) and keeps its
+// best bytes per second, which filters out most scheduling noise. Baseline
+// files hold one "name bytes_per_second" line per workload, with '#' starting
+// a comment. --record writes the measured figures in that format. Workloads
+// missing from the baseline are reported but never fail the gate.
+
+#include "MpmcRingBuffer.h"
+#include "PowerOfTwoRingBuffer.h"
+#include "RingBuffer.h"
+#include "SpscRingBuffer.h"
+#include "TypedRingBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+/**
+ * The ring buffer size for every workload. Small enough to stay in L2.
+ */
+const size_t CAPACITY = 64 << 10;
+
+/**
+ * The bytes written, then read, between clock checks.
+ */
+const size_t ROUND_SIZE = 16 << 10;
+
+/**
+ * How many times each workload runs.
+ */
+const int REPETITIONS = 3;
+
+struct Options {
+    string baseline;
+    double tolerance = 0.2;
+    string record;
+    double seconds = 0.2;
+};
+
+/**
+ * A ring buffer with writeBytes() and readBytes().
+ */
+template <class Ring> class ByteChannel {
+public:
+    ByteChannel(void *buffer, size_t size, size_t) : _ring(buffer, size) {}
+
+    size_t write(const void *source, size_t count) {
+        return _ring.writeBytes(source, count);
+    }
+
+    size_t read(void *destination, size_t count) {
+        return _ring.readBytes(destination, count);
+    }
+
+private:
+    Ring _ring;
+};
+
+/**
+ * An MpmcRingBuffer with one slot per chunk.
+ */
+class MpmcChannel {
+public:
+    MpmcChannel(void *buffer, size_t size, size_t chunkSize)
+        : _ring(buffer, size, chunkSize) {}
+
+    size_t write(const void *source, size_t count) {
+        return _ring.tryWrite(source, count) ? count : 0;
+    }
+
+    size_t read(void *destination, size_t count) {
+        size_t size = 0;
+        return _ring.tryRead(destination, count, size) ? size : 0;
+    }
+
+private:
+    MpmcRingBuffer _ring;
+};
+
+/**
+ * A TypedRingBuffer of 32-bit items, which has its own storage.
+ */
+class TypedChannel {
+public:
+    TypedChannel(void *, size_t, size_t)
+        : _storage(new Storage), _ring(_storage->items) {}
+
+    size_t write(const void *source, size_t count) {
+        return _ring.write(static_cast<const uint32_t *>(source),
+                           count / sizeof(uint32_t)) *
+               sizeof(uint32_t);
+    }
+
+    size_t read(void *destination, size_t count) {
+        return _ring.read(static_cast<uint32_t *>(destination),
+                          count / sizeof(uint32_t)) *
+               sizeof(uint32_t);
+    }
+
+private:
+    static const size_t COUNT = CAPACITY / sizeof(uint32_t);
+
+    struct Storage {
+        uint32_t items[COUNT];
+    };
+
+    unique_ptr<Storage> _storage;
+    TypedRingBuffer<uint32_t, COUNT> _ring;
+};
+
+/**
+ * Writes, then reads, rounds of chunks on one thread, and returns the bytes
+ * read per second.
+ */
+template <class Channel, size_t CHUNK_SIZE>
+double measureLoop(double seconds) {
+    // Size_t elements, for the alignment MpmcRingBuffer needs.
+    vector<size_t> buffer(CAPACITY / sizeof(size_t));
+    Channel channel(buffer.data(), CAPACITY, CHUNK_SIZE);
+    vector<char> source(CHUNK_SIZE, 'x');
+    vector<char> destination(CHUNK_SIZE);
+    const size_t CHUNKS = ROUND_SIZE / CHUNK_SIZE;
+
+    size_t bytes = 0;
+    auto start = Clock::now();
+    auto stop = start + chrono::duration<double>(seconds);
+    do {
+        for (size_t i = 0; i < CHUNKS; ++i) {
+            channel.write(source.data(), CHUNK_SIZE);
+        }
+        for (size_t i = 0; i < CHUNKS; ++i) {
+            bytes += channel.read(destination.data(), CHUNK_SIZE);
+        }
+    } while (Clock::now() < stop);
+    return bytes / chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Backs off after a failed attempt, yielding once the attempt count shows the
+ * other thread is probably not running.
+ */
+void backOff(unsigned &attempts) {
+    if (++attempts % 1024 == 0) {
+        this_thread::yield();
+    }
+}
+
+/**
+ * Streams chunks from a producer thread to a consumer thread through an
+ * SpscRingBuffer, and returns the bytes read per second.
+ */
+double measureSpscThreaded(double seconds) {
+    const size_t CHUNK_SIZE = 64;
+    vector<char> buffer(CAPACITY);
+    SpscRingBuffer ring(buffer.data(), buffer.size());
+    atomic<bool> done(false);
+
+    thread producer([&] {
+        char source[CHUNK_SIZE] = {};
+        unsigned attempts = 0;
+        while (!done.load(memory_order_relaxed)) {
+            if (ring.writeBytes(source, CHUNK_SIZE) == 0) {
+                backOff(attempts);
+            }
+        }
+    });
+
+    char destination[CHUNK_SIZE];
+    unsigned attempts = 0;
+    size_t bytes = 0;
+    auto start = Clock::now();
+    auto stop = start + chrono::duration<double>(seconds);
+    do {
+        for (size_t i = 0; i < ROUND_SIZE / CHUNK_SIZE; ++i) {
+            auto read = ring.readBytes(destination, CHUNK_SIZE);
+            if (read == 0) {
+                backOff(attempts);
+            }
+            bytes += read;
+        }
+    } while (Clock::now() < stop);
+    auto elapsed = chrono::duration<double>(Clock::now() - start).count();
+    done.store(true, memory_order_relaxed);
+    producer.join();
+    return bytes / elapsed;
+}
+
+struct Workload {
+    const char *name;
+    double (*measure)(double seconds);
+};
+
+const Workload WORKLOADS[] = {
+    {"ringbuffer-64", measureLoop<ByteChannel<RingBuffer>, 64>},
+    // A chunk size that does not divide the capacity, so that chunks split
+    // across the end of the buffer.
+    {"ringbuffer-wrap", measureLoop<ByteChannel<RingBuffer>, 100>},
+    {"ringbuffer-byte", measureLoop<ByteChannel<RingBuffer>, 1>},
+    {"poweroftwo-64", measureLoop<ByteChannel<PowerOfTwoRingBuffer>, 64>},
+    {"spsc-64", measureLoop<ByteChannel<SpscRingBuffer>, 64>},
+    {"spsc-threaded", measureSpscThreaded},
+    {"mpmc-64", measureLoop<MpmcChannel, 64>},
+    {"typed-u32", measureLoop<TypedChannel, 64>},
+};
+
+/**
+ * Reads a baseline file into a map from workload name to bytes per second.
+ */
+map<string, double> readBaseline(const string &path) {
+    ifstream file(path.c_str());
+    if (!file) {
+        fprintf(stderr, "error: cannot read baseline %s\n", path.c_str());
+        exit(2);
+    }
+    map<string, double> baseline;
+    string line;
+    while (getline(file, line)) {
+        auto comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+        istringstream fields(line);
+        string name;
+        double bytesPerSecond;
+        if (fields >> name >> bytesPerSecond) {
+            baseline[name] = bytesPerSecond;
+        }
+    }
+    return baseline;
+}
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "usage: %s [--baseline FILE] [--tolerance FRACTION]\n"
+            "       [--record FILE] [--seconds S]\n",
+            program);
+    exit(2);
+}
+
+Options parse(int argc, char *argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+        }
+        string name = argv[i];
+        const char *value = argv[++i];
+        if (name == "--baseline") {
+            options.baseline = value;
+        } else if (name == "--tolerance") {
+            options.tolerance = strtod(value, nullptr);
+        } else if (name == "--record") {
+            options.record = value;
+        } else if (name == "--seconds") {
+            options.seconds = strtod(value, nullptr);
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (options.tolerance < 0 || options.tolerance >= 1 ||
+        options.seconds <= 0) {
+        fprintf(stderr, "error: need a tolerance in [0, 1) and a positive "
+                        "duration\n");
+        exit(2);
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    auto options = parse(argc, argv);
+    map<string, double> baseline;
+    if (!options.baseline.empty()) {
+        baseline = readBaseline(options.baseline);
+    }
+
+    printf("%-16s %14s %14s %8s\n", "workload", "MB/s", "baseline MB/s",
+           "change");
+    ostringstream recorded;
+    bool failed = false;
+    for (const auto &workload : WORKLOADS) {
+        double best = 0;
+        for (int i = 0; i < REPETITIONS; ++i) {
+            best = max(best, workload.measure(options.seconds));
+        }
+        recorded << workload.name << ' ' << static_cast<uint64_t>(best)
+                 << '\n';
+
+        auto found = baseline.find(workload.name);
+        if (found == baseline.end()) {
+            printf("%-16s %14.1f %14s %8s\n", workload.name, best / 1e6, "-",
+                   "-");
+            continue;
+        }
+        auto change = best / found->second - 1;
+        auto regressed = change < -options.tolerance;
+        printf("%-16s %14.1f %14.1f %+7.1f%%%s\n", workload.name, best / 1e6,
+               found->second / 1e6, change * 100,
+               regressed ? "  REGRESSED" : "");
+        failed = failed || regressed;
+    }
+
+    if (!options.record.empty()) {
+        ofstream file(options.record.c_str());
+        file << "# Best bytes per second of each ringbufferthroughput "
+                "workload.\n"
+             << recorded.str();
+        if (!file) {
+            fprintf(stderr, "error: cannot write %s\n",
+                    options.record.c_str());
+            return 2;
+        }
+    }
+    if (failed) {
+        fflush(stdout);
+        fprintf(stderr, "error: throughput dropped by more than %.0f%%\n",
+                options.tolerance * 100);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,378 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares classes AsyncScheduler and AsyncRingBuffer.
+ *
+ * Needs C++20 coroutines. When the compiler does not provide them, this
+ * header declares nothing and leaves HDC_RINGBUFFER_HAS_COROUTINES undefined.
+ */
+
+#ifndef _HDC_ASYNCRINGBUFFER_H
+#define _HDC_ASYNCRINGBUFFER_H
+
+// Compilers with coroutines all have __has_include(), but older ones may not
+// parse it, hence the nesting.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#if __has_include(<coroutine>)
+
+#define HDC_RINGBUFFER_HAS_COROUTINES 1
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Queue of coroutines that are ready to resume, drained by an event loop.
+ *
+ * AsyncRingBuffer never resumes a coroutine from inside the call that
+ * unblocks it. It schedules the coroutine here instead, once, and the event
+ * loop resumes every ready coroutine in one batch with runReady(), so a
+ * single thread can drive any number of ring buffers without unbounded
+ * recursion between producers and consumers.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class AsyncScheduler {
+public:
+    /**
+     * Queues a coroutine to resume on the next call to runReady().
+     */
+    void schedule(std::coroutine_handle<> coroutine) {
+        _ready.push_back(coroutine);
+    }
+
+    /**
+     * Returns whether any coroutine is ready to resume.
+     */
+    bool hasReady() const { return !_ready.empty(); }
+
+    /**
+     * Resumes every coroutine that is ready.
+     *
+     * Coroutines that become ready while this runs wait for the next call.
+     *
+     * @return
+     * The number of coroutines resumed.
+     */
+    std::size_t runReady() {
+        _running.swap(_ready);
+        for (auto coroutine : _running) {
+            coroutine.resume();
+        }
+        auto count = _running.size();
+        _running.clear();
+        return count;
+    }
+
+private:
+    std::vector<std::coroutine_handle<>> _ready;   //!< The ready coroutines.
+    std::vector<std::coroutine_handle<>> _running; //!< The batch resuming.
+}; // class AsyncScheduler
+
+/**
+ * Awaitable adapter for a RingBuffer shared by one producer coroutine and one
+ * consumer coroutine.
+ *
+ * A producer awaits writeAsync(), which completes once all of its bytes are
+ * in the ring buffer. A consumer awaits readAtLeast(), then reads through
+ * this class. Both sides go through this class, so each commit checks the
+ * other side's waiter directly instead of polling:
+ *
+ * - a read, consume or discard copies a waiting producer's remaining bytes
+ *   into the space it just freed, and schedules the producer once they have
+ *   all been written;
+ * - a write or commit schedules a waiting consumer once the ring buffer holds
+ *   the number of bytes it asked for.
+ *
+ * Either way, a waiting coroutine is scheduled at most once per await, no
+ * matter how many commits it takes to unblock it.
+ *
+ * @code
+ * Task producer(AsyncRingBuffer &ring) {
+ *     co_await ring.writeAsync(message, size);
+ * }
+ *
+ * Task consumer(AsyncRingBuffer &ring) {
+ *     co_await ring.readAtLeast(sizeof(header));
+ *     ring.readBytes(&header, sizeof(header));
+ * }
+ * @endcode
+ *
+ * @warning
+ * At most one coroutine at a time may await writeAsync(), and at most one may
+ * await readAtLeast(). The client code must not write to or read from the
+ * underlying ring buffer directly while either waits.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class AsyncRingBuffer {
+public:
+    /**
+     * Awaitable returned by writeAsync().
+     */
+    class WriteAwaitable {
+    public:
+        /**
+         * Writes what fits right away, and returns whether that was all.
+         */
+        bool await_ready() {
+            _advance(_ring._ring.writeBytes(_source, _remaining));
+            _ring._wakeReader();
+            return _remaining == 0;
+        }
+
+        /**
+         * Registers the coroutine as the waiting producer.
+         */
+        void await_suspend(std::coroutine_handle<> coroutine) {
+            assert(_ring._writer == nullptr);
+            _coroutine = coroutine;
+            _ring._writer = this;
+        }
+
+        /**
+         * Returns the number of bytes written, which is all of them.
+         */
+        std::size_t await_resume() const { return _count; }
+
+    private:
+        friend class AsyncRingBuffer;
+
+        AsyncRingBuffer &_ring;             //!< The ring buffer.
+        const char *_source;                //!< The bytes left to write.
+        std::size_t _remaining;             //!< The number of bytes left.
+        std::size_t _count;                 //!< The number of bytes in all.
+        std::coroutine_handle<> _coroutine; //!< The waiting producer.
+
+        WriteAwaitable(AsyncRingBuffer &ring, const void *source,
+                       std::size_t count)
+            : _ring(ring), _source(static_cast<const char *>(source)),
+              _remaining(count), _count(count) {}
+
+        void _advance(std::size_t written) {
+            _source += written;
+            _remaining -= written;
+        }
+    }; // class WriteAwaitable
+
+    /**
+     * Awaitable returned by readAtLeast().
+     */
+    class ReadAwaitable {
+    public:
+        /**
+         * Returns whether enough bytes are readable already.
+         */
+        bool await_ready() const {
+            return _ring._ring.getReadableByteCount() >= _count;
+        }
+
+        /**
+         * Registers the coroutine as the waiting consumer.
+         */
+        void await_suspend(std::coroutine_handle<> coroutine) {
+            assert(_ring._reader == nullptr);
+            _coroutine = coroutine;
+            _ring._reader = this;
+        }
+
+        /**
+         * Returns the number of readable bytes, which is at least the number
+         * asked for.
+         */
+        std::size_t await_resume() const {
+            return _ring._ring.getReadableByteCount();
+        }
+
+    private:
+        friend class AsyncRingBuffer;
+
+        AsyncRingBuffer &_ring;             //!< The ring buffer.
+        std::size_t _count;                 //!< The number of bytes awaited.
+        std::coroutine_handle<> _coroutine; //!< The waiting consumer.
+
+        ReadAwaitable(AsyncRingBuffer &ring, std::size_t count)
+            : _ring(ring), _count(count) {}
+    }; // class ReadAwaitable
+
+    /**
+     * Async adapter constructor.
+     *
+     * @param[in] ring
+     * The ring buffer to adapt.
+     *
+     * @param[in] scheduler
+     * The scheduler to queue unblocked coroutines on.
+     */
+    AsyncRingBuffer(RingBuffer &ring, AsyncScheduler &scheduler)
+        : _ring(ring), _scheduler(scheduler), _writer(nullptr),
+          _reader(nullptr) {}
+
+    AsyncRingBuffer(const AsyncRingBuffer &) = delete;
+    AsyncRingBuffer &operator=(const AsyncRingBuffer &) = delete;
+
+    /**
+     * Returns the ring buffer, for inspecting it.
+     */
+    const RingBuffer &getRingBuffer() const { return _ring; }
+
+    /**
+     * Returns an awaitable that writes bytes into the ring buffer, suspending
+     * while it is full.
+     *
+     * @param[in] source
+     * The source buffer, which must stay valid until the await completes.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return
+     * An awaitable whose result is @p count.
+     */
+    WriteAwaitable writeAsync(const void *source, std::size_t count) {
+        return WriteAwaitable(*this, source, count);
+    }
+
+    /**
+     * Returns an awaitable that suspends until the ring buffer holds at least
+     * a number of bytes.
+     *
+     * @param[in] count
+     * The number of bytes to wait for. Must not exceed the size of the ring
+     * buffer.
+     *
+     * @return
+     * An awaitable whose result is the number of readable bytes.
+     */
+    ReadAwaitable readAtLeast(std::size_t count) {
+        assert(count <= _ring.getReadableByteCount() +
+                            _ring.getWritableByteCount());
+        return ReadAwaitable(*this, count);
+    }
+
+    /**
+     * Writes bytes into the ring buffer without waiting, as
+     * RingBuffer::writeBytes() does, and wakes the consumer if it now has
+     * enough bytes.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count) {
+        auto written = _ring.writeBytes(source, count);
+        _wakeReader();
+        return written;
+    }
+
+    /**
+     * Commits bytes written through RingBuffer::reserveWrite(), as
+     * RingBuffer::commitWrite() does, and wakes the consumer if it now has
+     * enough bytes.
+     */
+    void commitWrite(std::size_t count) {
+        _ring.commitWrite(count);
+        _wakeReader();
+    }
+
+    /**
+     * Reads bytes from the ring buffer, as RingBuffer::readBytes() does, and
+     * lets a waiting producer write into the freed space.
+     */
+    std::size_t readBytes(void *destination, std::size_t count) {
+        auto read = _ring.readBytes(destination, count);
+        _wakeWriter();
+        return read;
+    }
+
+    /**
+     * Removes bytes from the ring buffer, as RingBuffer::discardBytes() does,
+     * and lets a waiting producer write into the freed space.
+     */
+    std::size_t discardBytes(std::size_t count) {
+        auto discarded = _ring.discardBytes(count);
+        _wakeWriter();
+        return discarded;
+    }
+
+    /**
+     * Removes bytes inspected through RingBuffer::readableSpans(), as
+     * RingBuffer::consume() does, and lets a waiting producer write into the
+     * freed space.
+     */
+    void consume(std::size_t count) {
+        _ring.consume(count);
+        _wakeWriter();
+    }
+
+private:
+    RingBuffer &_ring;          //!< The adapted ring buffer.
+    AsyncScheduler &_scheduler; //!< Where unblocked coroutines go.
+    WriteAwaitable *_writer;    //!< The waiting producer, if any.
+    ReadAwaitable *_reader;     //!< The waiting consumer, if any.
+
+    /**
+     * Schedules the waiting consumer if the ring buffer holds enough bytes.
+     */
+    void _wakeReader() {
+        if (_reader != nullptr &&
+            _ring.getReadableByteCount() >= _reader->_count) {
+            _scheduler.schedule(_reader->_coroutine);
+            _reader = nullptr;
+        }
+    }
+
+    /**
+     * Writes the waiting producer's bytes into the free space, and schedules
+     * the producer once they are all written.
+     */
+    void _wakeWriter() {
+        if (_writer == nullptr) {
+            return;
+        }
+        _writer->_advance(_ring.writeBytes(_writer->_source,
+                                           _writer->_remaining));
+        if (_writer->_remaining == 0) {
+            _scheduler.schedule(_writer->_coroutine);
+            _writer = nullptr;
+        }
+        _wakeReader();
+    }
+}; // class AsyncRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif
+#endif
+
+#endif // _HDC_ASYNCRINGBUFFER_H
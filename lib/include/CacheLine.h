@@ -0,0 +1,69 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares the cache line size used to separate concurrently accessed data.
+ */
+
+#ifndef _HDC_CACHELINE_H
+#define _HDC_CACHELINE_H
+
+#include <cstddef>
+
+/**
+ * The alignment, in bytes, that keeps data written by different threads on
+ * different cache lines.
+ *
+ * Define this macro before including any ring buffer header, consistently for
+ * the library and all client code, to override the default.
+ *
+ * @note
+ * This deliberately does not default to
+ * <tt>std::hardware_destructive_interference_size</tt>. That constant is only
+ * available from C++17 and may differ between compiler flags, so a library
+ * built as C++11 and a client built as C++17 would disagree on the layout of
+ * the same class.
+ */
+#ifndef HDC_RINGBUFFER_CACHE_LINE_SIZE
+#if defined(__powerpc64__) || (defined(__aarch64__) && defined(__APPLE__))
+#define HDC_RINGBUFFER_CACHE_LINE_SIZE 128
+#else
+#define HDC_RINGBUFFER_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * The alignment, in bytes, that keeps data written by different threads on
+ * different cache lines.
+ */
+constexpr std::size_t CACHE_LINE_SIZE = HDC_RINGBUFFER_CACHE_LINE_SIZE;
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_CACHELINE_H
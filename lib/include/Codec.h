@@ -0,0 +1,108 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares interface Codec.
+ */
+
+#ifndef _HDC_CODEC_H
+#define _HDC_CODEC_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Block compression algorithm, such as LZ4 or Zstandard, for
+ * CompressingRingBuffer.
+ *
+ * The library ships no implementation, so that it does not depend on any
+ * compression library. An adapter is typically a few lines per method, for
+ * example @c LZ4_compressBound(), @c LZ4_compress_default() and
+ * @c LZ4_decompress_safe().
+ */
+class Codec {
+public:
+    virtual ~Codec() {}
+
+    /**
+     * Returns the largest compressed size of a block of a given size.
+     *
+     * @param[in] size
+     * The size of the block in bytes.
+     */
+    virtual std::size_t getMaxCompressedSize(std::size_t size) const = 0;
+
+    /**
+     * Compresses a block.
+     *
+     * @param[out] destination
+     * The buffer to compress into.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes, which is at least
+     * getMaxCompressedSize() of @p size.
+     *
+     * @param[in] source
+     * The block to compress.
+     *
+     * @param[in] size
+     * The size of the block in bytes.
+     *
+     * @return
+     * The compressed size in bytes, or 0 on failure.
+     */
+    virtual std::size_t compress(void *destination, std::size_t capacity,
+                                 const void *source, std::size_t size) = 0;
+
+    /**
+     * Decompresses a block.
+     *
+     * @param[out] destination
+     * The buffer to decompress into.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes, which is exactly the size
+     * of the original block.
+     *
+     * @param[in] source
+     * The compressed block.
+     *
+     * @param[in] size
+     * The compressed size in bytes.
+     *
+     * @return
+     * The decompressed size in bytes, which must equal @p capacity unless the
+     * compressed block is corrupt.
+     */
+    virtual std::size_t decompress(void *destination, std::size_t capacity,
+                                   const void *source, std::size_t size) = 0;
+}; // class Codec
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_CODEC_H
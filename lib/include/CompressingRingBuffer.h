@@ -0,0 +1,187 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class CompressingRingBuffer.
+ */
+
+#ifndef _HDC_COMPRESSINGRINGBUFFER_H
+#define _HDC_COMPRESSINGRINGBUFFER_H
+
+#include "Codec.h"
+#include "RingBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Compression adapter.
+ *
+ * Stores a byte stream in a RingBuffer as compressed blocks of a fixed
+ * logical size. Writes gather bytes into a block and compress each full block
+ * straight into the ring buffer's free span; reads decompress each block
+ * straight from the ring buffer's readable span, into the destination buffer
+ * if the whole block fits. A block is only copied through a scratch buffer
+ * when its bytes wrap around the end of the ring buffer, which a mirrored
+ * ring buffer never does.
+ *
+ * Each block is preceded by an 8-byte header with its stored and logical
+ * sizes. A block that does not shrink is stored uncompressed.
+ *
+ * @warning
+ * The client code must not write to or read from the underlying ring buffer
+ * directly while it holds compressed blocks, other than to inspect it.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class CompressingRingBuffer {
+public:
+    /**
+     * The number of ring buffer bytes each block takes up on top of its
+     * stored size.
+     */
+    static const std::size_t HEADER_SIZE = 8;
+
+    /**
+     * Compression adapter constructor.
+     *
+     * @param[in] ring
+     * The ring buffer to store the compressed blocks in.
+     *
+     * @param[in] codec
+     * The compression algorithm.
+     *
+     * @param[in] blockSize
+     * The logical size of each block in bytes. Must not be zero and must be
+     * less than 2 GiB.
+     */
+    CompressingRingBuffer(RingBuffer &ring, Codec &codec,
+                          std::size_t blockSize);
+
+    /**
+     * Returns the logical size of each block in bytes.
+     */
+    std::size_t getBlockSize() const { return _pending.size(); }
+
+    /**
+     * Returns whether there is nothing to read.
+     *
+     * @note
+     * Bytes that are still gathering into a block do not count until flush()
+     * stores them.
+     */
+    bool isEmpty() const { return getReadableByteCount() == 0; }
+
+    /**
+     * Returns the number of bytes that can be read, before compression.
+     */
+    std::size_t getReadableByteCount() const {
+        return _storedLogicalByteCount + _decodedSize - _decodedOffset;
+    }
+
+    /**
+     * Returns the number of bytes that the readable blocks take up in the
+     * ring buffer, including their headers.
+     */
+    std::size_t getCompressedByteCount() const {
+        return _ring.getReadableByteCount();
+    }
+
+    /**
+     * Returns the number of written bytes that are gathering into a block and
+     * are not readable yet.
+     */
+    std::size_t getPendingByteCount() const { return _pendingSize; }
+
+    /**
+     * Writes bytes, compressing each block as it fills.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return
+     * The number of bytes written, which may be less than @p count once the
+     * ring buffer has no room for the next compressed block.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count);
+
+    /**
+     * Stores the bytes gathering into a block as a shorter block, so that they
+     * become readable.
+     *
+     * @return
+     * Whether there were no such bytes or they were stored, which is
+     * @c false if the ring buffer has no room for the block.
+     */
+    bool flush();
+
+    /**
+     * Reads bytes, decompressing blocks as needed.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @return
+     * The number of bytes read.
+     */
+    std::size_t readBytes(void *destination, std::size_t count);
+
+    /**
+     * Discards everything, including the bytes gathering into a block, and
+     * clears the ring buffer.
+     */
+    void clear();
+
+private:
+    RingBuffer &_ring;                   //!< The ring buffer.
+    Codec &_codec;                       //!< The compression algorithm.
+    std::vector<char> _pending;          //!< The block being gathered.
+    std::size_t _pendingSize;            //!< The bytes in the block.
+    std::vector<char> _decoded;          //!< The block being read.
+    std::size_t _decodedSize;            //!< The bytes in the block.
+    std::size_t _decodedOffset;          //!< The bytes read from the block.
+    std::vector<char> _scratch;          //!< A block that wraps around.
+    std::size_t _storedLogicalByteCount; //!< Logical bytes in the ring.
+
+    bool _writeBlock(const char *block, std::size_t size);
+    void _readBlock(char *destination, std::size_t size,
+                    std::size_t storedSize, bool raw);
+}; // class CompressingRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_COMPRESSINGRINGBUFFER_H
@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Declares the copy functions that the ring buffers can use instead of
+ * <tt>std::memcpy()</tt>.
+ */
+
+#ifndef _HDC_COPYFUNCTION_H
+#define _HDC_COPYFUNCTION_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * A function that copies @p count bytes from @p source to @p destination, with
+ * the semantics of <tt>std::memcpy()</tt>.
+ *
+ * The copy must be complete, and visible to other threads as if made with
+ * ordinary stores, by the time the function returns.
+ */
+typedef void (*CopyFunction)(void *destination, const void *source,
+                             std::size_t count);
+
+/**
+ * Copies bytes with non-temporal (streaming) stores, which write to memory
+ * without pulling the destination into the cache.
+ *
+ * Worth it for copies much larger than the cache, whose destination will not
+ * be read again soon. For smaller copies, it is slower than
+ * <tt>std::memcpy()</tt>.
+ *
+ * Copies the unaligned head and tail of the destination with
+ * <tt>std::memcpy()</tt> and streams the cache lines in between, using AVX if
+ * the processor supports it and SSE2 otherwise. Ends with a store fence, so
+ * the copy is ordered before any later store. Falls back to
+ * <tt>std::memcpy()</tt> on processors other than x86.
+ *
+ * @param[out] destination
+ * The destination buffer.
+ *
+ * @param[in] source
+ * The source buffer.
+ *
+ * @param[in] count
+ * The number of bytes to copy.
+ */
+void nonTemporalCopy(void *destination, const void *source, std::size_t count);
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_COPYFUNCTION_H
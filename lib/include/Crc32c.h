@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares the CRC32C (Castagnoli) checksum functions.
+ */
+
+#ifndef _HDC_CRC32C_H
+#define _HDC_CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Computes the CRC32C checksum of a range of bytes, as used by iSCSI, ext4 and
+ * SCTP.
+ *
+ * Uses the SSE4.2 @c crc32 instruction on x86-64 processors that have it,
+ * the ARMv8 CRC instructions when compiled for them, and a lookup table
+ * otherwise.
+ *
+ * @param[in] data
+ * The bytes to checksum.
+ *
+ * @param[in] size
+ * The number of bytes.
+ *
+ * @param[in] crc
+ * The checksum of the bytes before these, or 0 to start, so that
+ * <tt>crc32c(b, m, crc32c(a, n))</tt> is the checksum of @c a followed by
+ * @c b.
+ *
+ * @return
+ * The checksum of all bytes so far.
+ */
+std::uint32_t crc32c(const void *data, std::size_t size,
+                     std::uint32_t crc = 0);
+
+/**
+ * Copies bytes, with the semantics of <tt>std::memcpy()</tt>, and computes
+ * their CRC32C checksum in the same pass.
+ *
+ * @param[out] destination
+ * The destination buffer.
+ *
+ * @param[in] source
+ * The bytes to copy and checksum.
+ *
+ * @param[in] size
+ * The number of bytes.
+ *
+ * @param[in] crc
+ * The checksum of the bytes before these, as for crc32c().
+ *
+ * @return
+ * The checksum of all bytes so far.
+ */
+std::uint32_t copyCrc32c(void *destination, const void *source,
+                         std::size_t size, std::uint32_t crc = 0);
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_CRC32C_H
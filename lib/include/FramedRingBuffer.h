@@ -0,0 +1,241 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class FramedRingBuffer.
+ */
+
+#ifndef _HDC_FRAMEDRINGBUFFER_H
+#define _HDC_FRAMEDRINGBUFFER_H
+
+#include "RingBuffer.h"
+#include "Span.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Message framing adapter.
+ *
+ * Stores discrete messages in a RingBuffer, each one prefixed by its size as
+ * an unsigned LEB128 varint (one byte for messages under 128 bytes, two for
+ * messages under 16 KiB). Each call makes a single pass over the ring buffer
+ * state: a message is written or removed together with its header, so a
+ * partial message is never visible.
+ *
+ * @warning
+ * The client code must not write to or read from the underlying ring buffer
+ * directly while it holds framed messages, other than to clear it.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class FramedRingBuffer {
+public:
+    /**
+     * The largest possible header size in bytes.
+     */
+    static const std::size_t MAX_HEADER_SIZE =
+        (std::numeric_limits<std::size_t>::digits + 6) / 7;
+
+    /**
+     * Framing adapter constructor.
+     *
+     * @param[in] ring
+     * The ring buffer to store the messages in.
+     */
+    explicit FramedRingBuffer(RingBuffer &ring)
+        : _ring(ring), _droppedMessageCount(0) {}
+
+    /**
+     * Returns whether the ring buffer holds no messages.
+     */
+    bool isEmpty() const { return _ring.isEmpty(); }
+
+    /**
+     * Returns the number of ring buffer bytes a message of a given size takes
+     * up, including its header.
+     *
+     * @param[in] size
+     * The size of the message in bytes.
+     */
+    static std::size_t getFramedSize(std::size_t size);
+
+    /**
+     * Writes a message into the ring buffer.
+     *
+     * @param[in] message
+     * The message. May be @c nullptr if @p size is 0.
+     *
+     * @param[in] size
+     * The size of the message in bytes.
+     *
+     * @return
+     * Whether the message was written, which is @c false if the ring buffer
+     * does not have room for the message and its header.
+     */
+    bool writeMessage(const void *message, std::size_t size);
+
+    /**
+     * Writes a message into the ring buffer, removing the oldest messages to
+     * make room if needed.
+     *
+     * @param[in] message
+     * The message. May be @c nullptr if @p size is 0.
+     *
+     * @param[in] size
+     * The size of the message in bytes.
+     *
+     * @return
+     * Whether the message was written, which is @c false only if the message
+     * and its header are larger than the whole ring buffer.
+     *
+     * @note
+     * Only ever removes whole messages, so the ring buffer always starts at a
+     * message boundary.
+     */
+    bool overwriteMessage(const void *message, std::size_t size);
+
+    /**
+     * Returns the total number of messages that overwriteMessage() has
+     * removed.
+     */
+    std::uint64_t getDroppedMessageCount() const {
+        return _droppedMessageCount;
+    }
+
+    /**
+     * Returns the size of the first message in the ring buffer.
+     *
+     * @param[out] size
+     * The size of the message in bytes.
+     *
+     * @return
+     * Whether the ring buffer holds a message.
+     */
+    bool peekMessageSize(std::size_t &size) const;
+
+    /**
+     * Reads the first message in the ring buffer into a destination buffer
+     * without removing it from the ring buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes.
+     *
+     * @param[out] size
+     * The size of the message in bytes, if the ring buffer holds a message.
+     *
+     * @return
+     * Whether the message was read, which is @c false if the ring buffer holds
+     * no message or if the message is larger than @p capacity.
+     */
+    bool peekMessage(void *destination, std::size_t capacity,
+                     std::size_t &size) const;
+
+    /**
+     * Returns the first message in the ring buffer without copying it, so that
+     * the client code can inspect it in place.
+     *
+     * @param[out] spans
+     * The message, split in two if it wraps around the end of the buffer.
+     *
+     * @return
+     * Whether the ring buffer holds a message.
+     *
+     * @note
+     * Any operation that modifies the ring buffer invalidates the returned
+     * spans.
+     */
+    bool peekMessageSpans(ConstSpanPair &spans) const;
+
+    /**
+     * Reads the first message in the ring buffer into a destination buffer
+     * and removes it from the ring buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes.
+     *
+     * @param[out] size
+     * The size of the message in bytes, if the ring buffer holds a message.
+     *
+     * @return
+     * Whether the message was read, which is @c false if the ring buffer holds
+     * no message or if the message is larger than @p capacity. In the latter
+     * case, the message stays in the ring buffer.
+     */
+    bool readMessage(void *destination, std::size_t capacity,
+                     std::size_t &size);
+
+    /**
+     * Removes the first message from the ring buffer without copying it.
+     *
+     * @return
+     * Whether a message was removed, which is @c false if the ring buffer
+     * holds no message.
+     */
+    bool skipMessage();
+
+    /**
+     * Removes all messages from the ring buffer.
+     */
+    void clear() { _ring.clear(); }
+
+private:
+    RingBuffer &_ring;                  //!< The ring buffer holding messages.
+    std::uint64_t _droppedMessageCount; //!< Messages lost to overwrites.
+
+    /**
+     * Locates the first message in the ring buffer.
+     *
+     * @param[out] spans
+     * The readable bytes of the ring buffer.
+     *
+     * @param[out] headerSize
+     * The size of the message header in bytes.
+     *
+     * @param[out] size
+     * The size of the message in bytes.
+     *
+     * @return
+     * Whether the ring buffer holds a complete message.
+     */
+    bool _findMessage(ConstSpanPair &spans, std::size_t &headerSize,
+                      std::size_t &size) const;
+}; // class FramedRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_FRAMEDRINGBUFFER_H
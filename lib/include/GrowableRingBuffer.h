@@ -0,0 +1,141 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class GrowableRingBuffer.
+ */
+
+#ifndef _HDC_GROWABLERINGBUFFER_H
+#define _HDC_GROWABLERINGBUFFER_H
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Ring buffer that owns its buffer and grows it on demand.
+ *
+ * writeBytes() and reserve() double the buffer whenever the data would not
+ * fit, up to a maximum size, so a burst larger than the initial size is
+ * absorbed instead of producing short writes. Each byte is moved amortized
+ * O(1) times: RingBuffer::resize() copies the readable bytes into the new
+ * buffer in at most two copies, without draining the ring buffer. The buffer
+ * never shrinks.
+ *
+ * Everything other than writing goes through getRingBuffer().
+ *
+ * @warning
+ * Growing invalidates any spans returned by the ring buffer.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class GrowableRingBuffer {
+public:
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] initialSize
+     * The initial size of the buffer in bytes. Must not be zero.
+     *
+     * @param[in] maximumSize
+     * The size in bytes beyond which the buffer does not grow. Must not be
+     * less than @p initialSize.
+     */
+    explicit GrowableRingBuffer(
+        std::size_t initialSize,
+        std::size_t maximumSize = std::numeric_limits<std::size_t>::max());
+
+    /**
+     * Returns the current size of the buffer in bytes.
+     */
+    std::size_t getSize() const { return _size; }
+
+    /**
+     * Returns the size in bytes beyond which the buffer does not grow.
+     */
+    std::size_t getMaximumSize() const { return _maximumSize; }
+
+    /**
+     * Grows the buffer, if needed, so that a number of bytes can be written.
+     *
+     * @param[in] count
+     * The number of bytes to make room for.
+     *
+     * @return
+     * Whether the ring buffer has room for @p count bytes, which is @c false if
+     * that would take a buffer larger than the maximum size, or if allocating
+     * the larger buffer fails.
+     */
+    bool reserve(std::size_t count);
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer, growing the
+     * buffer if needed.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return
+     * The number of bytes written, which is less than @p count only if the
+     * buffer cannot grow enough. In that case, the buffer grows as far as it
+     * can first.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count) {
+        reserve(std::min(count, _maximumSize - _ring.getReadableByteCount()));
+        return _ring.writeBytes(source, count);
+    }
+
+    /**
+     * Returns the ring buffer, for reading and for anything else that does
+     * not need the buffer to grow.
+     */
+    RingBuffer &getRingBuffer() { return _ring; }
+
+    /**
+     * Returns the ring buffer.
+     */
+    const RingBuffer &getRingBuffer() const { return _ring; }
+
+private:
+    std::unique_ptr<char[]> _buffer; //!< The owned buffer.
+    std::size_t _size;               //!< The size of the buffer.
+    std::size_t _maximumSize;        //!< The size limit of the buffer.
+    RingBuffer _ring;                //!< The ring buffer over the buffer.
+}; // class GrowableRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_GROWABLERINGBUFFER_H
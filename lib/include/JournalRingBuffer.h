@@ -0,0 +1,311 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class JournalRingBuffer.
+ */
+
+#ifndef _HDC_JOURNALRINGBUFFER_H
+#define _HDC_JOURNALRINGBUFFER_H
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Ring buffer backed by a memory-mapped file, whose contents survive a crash.
+ *
+ * The file starts with a header page of HEADER_SIZE bytes, followed by the
+ * data. The header holds the position of the readable bytes in two slots,
+ * each with an epoch and a CRC32C checksum. commit() writes the current
+ * position to the older slot, so a crash in the middle of a commit leaves the
+ * newer slot intact. Opening the file again restores the ring buffer from
+ * whichever slot has the highest epoch and a correct checksum, without
+ * scanning the data:
+ *
+ * @code
+ * JournalRingBuffer journal("audit.ring", 64 << 20);
+ * if (!journal.isValid()) {
+ *     // Could not open the file, or it does not hold a journal.
+ * }
+ * journal.writeBytes(record, record_size);
+ * journal.flush();
+ * @endcode
+ *
+ * Reads go directly to memory and writes go through writeBytes(), which keeps
+ * track of the bytes written since the last flush(). There are two levels of
+ * persistence:
+ * - commit() only updates the header in memory, in O(1) and without a system
+ *   call. Since the memory is a shared mapping of the file, the committed
+ *   state survives the process crashing, but not the system crashing.
+ * - flush() writes the bytes written since the last flush() back to the file,
+ *   then commits and writes the header back to the file. The flushed state
+ *   survives the system crashing too.
+ *
+ * After a crash, the ring buffer holds what it held at the last commit():
+ * bytes written since are lost, and bytes read since are readable again. To
+ * keep that promise, writeBytes() never overwrites the bytes of the last
+ * commit, even once they have been read, so reading alone does not make room
+ * for writing: commit() (or flush()) does.
+ *
+ * Everything other than writing goes through getRingBuffer().
+ *
+ * @warning
+ * After a system crash, the ring buffer may hold bytes that were never
+ * written if commit() was called after the last flush(), since the system
+ * may write the header back to the file before the data. Use flush() alone
+ * when that matters.
+ *
+ * @warning
+ * Neither the destructor nor any other function commits implicitly.
+ *
+ * @warning
+ * At most one JournalRingBuffer may use a file at any given time, and the
+ * file is in the byte order of the host that created it. The client code is
+ * responsible for synchronization.
+ */
+class JournalRingBuffer {
+public:
+    /**
+     * The size of the header page at the start of the file, in bytes.
+     */
+    static const std::size_t HEADER_SIZE = 4096;
+
+    /**
+     * Opens the journal in a file, creating the file if it does not exist.
+     *
+     * @param[in] path
+     * The path of the file.
+     *
+     * @param[in] capacity
+     * The capacity in bytes. Must not be zero. The file's size is
+     * HEADER_SIZE plus the capacity.
+     *
+     * @note
+     * Check isValid() to find out whether the file could be opened and
+     * mapped, and, if it existed, whether it holds a journal of this capacity
+     * with at least one intact header slot. Check isRecovered() to find out
+     * whether it existed.
+     */
+    JournalRingBuffer(const char *path, std::size_t capacity);
+
+    /**
+     * Unmaps the file, without committing.
+     */
+    ~JournalRingBuffer();
+
+    JournalRingBuffer(const JournalRingBuffer &) = delete;
+    JournalRingBuffer &operator=(const JournalRingBuffer &) = delete;
+
+    /**
+     * Returns whether the journal was opened successfully. No other function
+     * may be called if not.
+     */
+    bool isValid() const { return _ring != nullptr; }
+
+    /**
+     * Returns whether the file already held a journal, whose contents are now
+     * readable.
+     */
+    bool isRecovered() const { return _recovered; }
+
+    /**
+     * Returns the capacity in bytes.
+     */
+    std::size_t getCapacity() const { return _capacity; }
+
+    /**
+     * Returns the epoch of the last commit, which starts at 1 in a new file
+     * and increases by 1 with each commit.
+     */
+    std::uint64_t getEpoch() const { return _epoch; }
+
+    /**
+     * Returns the number of readable bytes that were written since the last
+     * flush().
+     */
+    std::size_t getDirtyByteCount() const {
+        _assertValid();
+        return std::min(_dirty, _ring->getReadableByteCount());
+    }
+
+    /**
+     * Returns the number of bytes that writeBytes() can write, which excludes
+     * the space still holding the bytes of the last commit.
+     */
+    std::size_t getWritableByteCount() const;
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return
+     * The number of bytes written.
+     *
+     * @note
+     * The number of bytes written may be less than the number requested if
+     * the ring buffer becomes full, or if the rest of the free space still
+     * holds bytes of the last commit that have since been read.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count) {
+        _assertValid();
+        auto written =
+            _ring->writeBytes(source, std::min(count, getWritableByteCount()));
+        _dirty = std::min(_dirty + written, _capacity);
+        return written;
+    }
+
+    /**
+     * Records the current contents of the ring buffer in the header, so that
+     * they survive the process crashing.
+     */
+    void commit();
+
+    /**
+     * Writes the bytes written since the last flush() back to the file,
+     * commits, then writes the header back to the file, so that the current
+     * contents survive the system crashing.
+     *
+     * Only the pages holding readable bytes written since the last flush()
+     * are written back, with @c msync() on POSIX systems and
+     * @c FlushViewOfFile() on Windows.
+     *
+     * @return
+     * Whether the system reported success. If not, the state that survives a
+     * system crash is unknown, and the next flush() writes the same bytes
+     * back again.
+     */
+    bool flush();
+
+    /**
+     * Returns the ring buffer, for reading and for anything else that does
+     * not write.
+     *
+     * @warning
+     * Bytes written to the ring buffer directly are committed, but flush()
+     * does not write them back to the file, and they may overwrite the bytes
+     * of the last commit.
+     */
+    RingBuffer &getRingBuffer() {
+        _assertValid();
+        return *_ring;
+    }
+
+    /**
+     * Returns the ring buffer.
+     */
+    const RingBuffer &getRingBuffer() const {
+        _assertValid();
+        return *_ring;
+    }
+
+private:
+    /**
+     * A position of the readable bytes, as committed.
+     */
+    struct _Slot {
+        std::uint64_t epoch;    //!< The epoch of the commit.
+        std::uint64_t offset;   //!< The offset of the first readable byte.
+        std::uint64_t count;    //!< The number of readable bytes.
+        std::uint32_t crc;      //!< The CRC32C of the fields above.
+        std::uint32_t reserved; //!< Zero.
+    };
+
+    /**
+     * The header at the start of the file.
+     */
+    struct _Header {
+        std::uint32_t magic;    //!< MAGIC once created.
+        std::uint32_t version;  //!< VERSION.
+        std::uint64_t capacity; //!< The capacity in bytes.
+        _Slot slots[2];         //!< The slot for each parity of epoch.
+    };
+
+    /** Identifies a file holding a journal. */
+    static const std::uint32_t MAGIC = 0x4844434a; // "HDCJ"
+
+    /** The layout version. Changes whenever the layout does. */
+    static const std::uint32_t VERSION = 1;
+
+    char *_memory;                     //!< The mapping of the whole file.
+    std::size_t _capacity;             //!< The capacity.
+    _Header *_header;                  //!< The header, in the mapping.
+    std::uint64_t _epoch;              //!< The epoch of the last commit.
+    std::size_t _committedOffset;      //!< The offset of the last commit.
+    std::size_t _committedCount;       //!< The bytes in the last commit.
+    std::size_t _dirty;                //!< Bytes written since flush().
+    bool _recovered;                   //!< Whether the file held a journal.
+    std::unique_ptr<RingBuffer> _ring; //!< The ring buffer over the data.
+#if defined(_WIN32)
+    void *_file; //!< The file, for FlushFileBuffers().
+#endif
+
+    /**
+     * Returns the checksum that a slot holds if it is intact.
+     */
+    static std::uint32_t _checksum(const _Slot &slot);
+
+    /**
+     * Opens and maps the file, creating it with @p size bytes if it does not
+     * exist or is empty, and sets @p created accordingly.
+     */
+    bool _open(const char *path, std::size_t size, bool &created);
+
+    /**
+     * Formats a new file as an empty journal.
+     */
+    bool _format();
+
+    /**
+     * Restores the ring buffer from the newest intact slot in the header.
+     */
+    bool _recover();
+
+    /**
+     * Writes the pages of the mapping that hold a range of bytes back to the
+     * file.
+     */
+    bool _sync(const char *data, std::size_t count);
+
+    void _unmap();
+    void _assertValid() const;
+}; // class JournalRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_JOURNALRINGBUFFER_H
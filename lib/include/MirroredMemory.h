@@ -0,0 +1,123 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class MirroredMemory.
+ */
+
+#ifndef _HDC_MIRROREDMEMORY_H
+#define _HDC_MIRROREDMEMORY_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Memory that is mapped twice, back to back, in virtual memory.
+ *
+ * The byte at offset @c i and the byte at offset <tt>i + getSize()</tt> are
+ * the same physical byte, for every @c i less than getSize(). Handing this
+ * memory to a RingBuffer with the @c mirrored flag set lets the ring buffer
+ * read and write any region, including one that wraps around the end of the
+ * buffer, as one contiguous range.
+ *
+ * Uses @c memfd_create() and @c mmap() on Linux, @c shm_open() and @c mmap()
+ * on other POSIX systems, and @c VirtualAlloc2() and @c MapViewOfFile3() on
+ * Windows 10 version 1803 or later.
+ *
+ * @warning
+ * The memory must outlive any ring buffer that uses it.
+ */
+class MirroredMemory {
+public:
+    /**
+     * Maps the memory.
+     *
+     * @param[in] minimumSize
+     * The minimum size of the memory in bytes. The actual size is rounded up
+     * to a multiple of getGranularity().
+     *
+     * @note
+     * Check isValid() to find out whether the mapping succeeded.
+     */
+    explicit MirroredMemory(std::size_t minimumSize);
+
+    /**
+     * Unmaps the memory.
+     */
+    ~MirroredMemory();
+
+    MirroredMemory(const MirroredMemory &) = delete;
+    MirroredMemory &operator=(const MirroredMemory &) = delete;
+
+    /**
+     * Takes over the mapping of another object, leaving the other object
+     * invalid.
+     */
+    MirroredMemory(MirroredMemory &&other) noexcept;
+
+    /**
+     * Unmaps the memory, then takes over the mapping of another object,
+     * leaving the other object invalid.
+     */
+    MirroredMemory &operator=(MirroredMemory &&other) noexcept;
+
+    /**
+     * Returns whether the memory was mapped successfully.
+     */
+    bool isValid() const { return _buffer != nullptr; }
+
+    /**
+     * Returns the first byte of the memory, or @c nullptr if the mapping
+     * failed.
+     *
+     * The range <tt>[getBuffer(), getBuffer() + 2 * getSize())</tt> is
+     * accessible.
+     */
+    void *getBuffer() const { return _buffer; }
+
+    /**
+     * Returns the size of the memory in bytes, not counting the mirror, or 0
+     * if the mapping failed.
+     */
+    std::size_t getSize() const { return _size; }
+
+    /**
+     * Returns the granularity, in bytes, to which sizes are rounded up.
+     */
+    static std::size_t getGranularity();
+
+private:
+    char *_buffer;     //!< The first mapping, followed by the second.
+    std::size_t _size; //!< The size of each mapping.
+
+    void _unmap();
+}; // class MirroredMemory
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_MIRROREDMEMORY_H
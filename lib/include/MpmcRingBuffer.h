@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class MpmcRingBuffer.
+ */
+
+#ifndef _HDC_MPMCRINGBUFFER_H
+#define _HDC_MPMCRINGBUFFER_H
+
+#include "CacheLine.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+// Structure was padded due to alignment specifier.
+#pragma warning(disable : 4324)
+#endif
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Multi-producer, multi-consumer ring buffer adapter.
+ *
+ * Adapts a client-supplied buffer into a bounded queue of fixed-size slots
+ * that any number of producer and consumer threads can use concurrently
+ * without locking. Each slot holds one message of up to getSlotSize() bytes.
+ *
+ * Unlike the byte-oriented ring buffers, this class moves whole messages:
+ * tryWrite() either writes the entire message into one slot or writes nothing.
+ *
+ * @note
+ * Uses <tt>std::memcpy()</tt> to copy data.
+ *
+ * @note
+ * The enqueue and dequeue positions live on separate cache lines. If you
+ * allocate the ring buffer object dynamically, use an allocator that honours
+ * over-aligned types (C++17 or later) to keep them apart.
+ *
+ * @warning
+ * The client code must not reuse or delete the supplied buffer memory for the
+ * lifetime of the ring buffer.
+ */
+class MpmcRingBuffer {
+public:
+    /**
+     * Returns the buffer size needed for a given number of slots.
+     *
+     * @param[in] slotCount
+     * The number of slots. Must be a power of two.
+     *
+     * @param[in] slotSize
+     * The largest message size in bytes.
+     */
+    static std::size_t getBufferSize(std::size_t slotCount,
+                                     std::size_t slotSize) {
+        return slotCount * _getStride(slotSize);
+    }
+
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] buffer
+     * The buffer to adapt into a ring buffer. Must be aligned for
+     * <tt>std::size_t</tt>.
+     *
+     * @param[in] size
+     * The size of the buffer in bytes. Must hold at least one slot. The ring
+     * buffer uses the largest power-of-two number of slots that fits.
+     *
+     * @param[in] slotSize
+     * The largest message size in bytes.
+     */
+    MpmcRingBuffer(void *buffer, std::size_t size, std::size_t slotSize);
+
+    MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+    MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+    /**
+     * Returns the number of slots.
+     */
+    std::size_t getSlotCount() const { return _mask + 1; }
+
+    /**
+     * Returns the largest message size in bytes.
+     */
+    std::size_t getSlotSize() const { return _slotSize; }
+
+    /**
+     * Returns the number of messages that can be read from the ring buffer.
+     *
+     * @note
+     * The result is only a snapshot: other threads may change the state at
+     * any time.
+     */
+    std::size_t getReadableCount() const {
+        auto dequeue = _dequeue.load(std::memory_order_acquire);
+        auto enqueue = _enqueue.load(std::memory_order_acquire);
+        auto count = enqueue - dequeue;
+        // A concurrent dequeue can overtake the enqueue load above.
+        return count > getSlotCount() ? 0 : count;
+    }
+
+    /**
+     * Returns whether the ring buffer is empty.
+     *
+     * @note
+     * The result is only a snapshot: other threads may change the state at
+     * any time.
+     */
+    bool isEmpty() const { return getReadableCount() == 0; }
+
+    /**
+     * Writes a message into a free slot.
+     *
+     * @param[in] message
+     * The message. May be @c nullptr if @p size is 0.
+     *
+     * @param[in] size
+     * The size of the message in bytes. Must not exceed getSlotSize().
+     *
+     * @return
+     * Whether the message was written, which is @c false if every slot is
+     * full.
+     */
+    bool tryWrite(const void *message, std::size_t size);
+
+    /**
+     * Reads the oldest message out of its slot.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes. If the message is larger,
+     * only the first @p capacity bytes are copied and the rest is lost.
+     *
+     * @param[out] size
+     * The size of the message in bytes.
+     *
+     * @return
+     * Whether a message was read, which is @c false if every slot is empty.
+     */
+    bool tryRead(void *destination, std::size_t capacity, std::size_t &size);
+
+private:
+    /**
+     * The header at the start of each slot. The message follows it.
+     */
+    struct _Slot {
+        /** The position the slot is ready for. Equals the enqueue position
+            when free and the dequeue position plus one when full. */
+        std::atomic<std::size_t> sequence;
+        std::size_t size; //!< The size of the message in the slot.
+    };
+
+    char *_buffer;         //!< The client-supplied buffer.
+    std::size_t _slotSize; //!< The largest message size.
+    std::size_t _stride;   //!< The distance between slots.
+    std::size_t _mask;     //!< The number of slots minus one.
+
+    /** Counts messages enqueued. Shared by the producers. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _enqueue;
+
+    /** Counts messages dequeued. Shared by the consumers. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _dequeue;
+
+    /**
+     * Returns the distance between slots holding messages of up to
+     * @p slotSize bytes.
+     */
+    static std::size_t _getStride(std::size_t slotSize) {
+        return (sizeof(_Slot) + slotSize + alignof(_Slot) - 1) /
+               alignof(_Slot) * alignof(_Slot);
+    }
+
+    /**
+     * Returns the slot for position @p position.
+     */
+    _Slot *_getSlot(std::size_t position) const {
+        return reinterpret_cast<_Slot *>(_buffer +
+                                         (position & _mask) * _stride);
+    }
+
+    void _assertValid() const;
+}; // class MpmcRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _HDC_MPMCRINGBUFFER_H
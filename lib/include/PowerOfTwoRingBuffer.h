@@ -0,0 +1,280 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class PowerOfTwoRingBuffer.
+ */
+
+#ifndef _HDC_POWEROFTWORINGBUFFER_H
+#define _HDC_POWEROFTWORINGBUFFER_H
+
+#include "Span.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Ring buffer adapter for buffers whose size is a power of two.
+ *
+ * Has the same interface as RingBuffer. Restricting the size to a power of two
+ * lets this class track the read and write locations with free-running 64-bit
+ * counters and find a byte in the buffer by masking, so the readable and
+ * writable byte counts are a single subtraction with no branches.
+ *
+ * @note
+ * Uses <tt>std::memcpy()</tt> to copy data.
+ *
+ * @warning
+ * The client code must not reuse or delete the supplied buffer memory for the
+ * lifetime of the ring buffer.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class PowerOfTwoRingBuffer {
+public:
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] buffer
+     * The buffer to adapt into a ring buffer.
+     *
+     * @param[in] size
+     * The size of the buffer in bytes. Must be a power of two.
+     */
+    PowerOfTwoRingBuffer(void *buffer, std::size_t size)
+        : _buffer(static_cast<char *>(buffer)), _mask(size - 1), _read(0),
+          _write(0) {
+        _assertValid();
+    }
+
+    /**
+     * Returns whether the ring buffer is empty.
+     */
+    bool isEmpty() const { return _write == _read; }
+
+    /**
+     * Returns whether the ring buffer is full.
+     */
+    bool isFull() const { return getReadableByteCount() == getSize(); }
+
+    /**
+     * Returns the size of the buffer in bytes.
+     */
+    std::size_t getSize() const { return _mask + 1; }
+
+    /**
+     * Returns the number of bytes that can be read from the ring buffer.
+     */
+    std::size_t getReadableByteCount() const {
+        _assertValid();
+        return static_cast<std::size_t>(_write - _read);
+    }
+
+    /**
+     * Returns the number of bytes that can be written to the ring buffer.
+     */
+    std::size_t getWritableByteCount() const {
+        return getSize() - getReadableByteCount();
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @return
+     * The number of bytes read.
+     *
+     * @note
+     * The number of bytes read may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t readBytes(void *destination, std::size_t count) {
+        assert(destination != nullptr);
+        count = _peekBytes(destination, count, 0);
+        _read += count;
+        return count;
+    }
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return The number of bytes written.
+     *
+     * @note
+     * The number of bytes written may be less than the number requested if the
+     * ring buffer becomes full.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count);
+
+    /**
+     * Discards bytes from the ring buffer.
+     *
+     * @param[in] count
+     * The number of bytes to discard.
+     *
+     * @return
+     * The number of bytes discarded.
+     *
+     * @note
+     * The number of bytes discarded may be less than the number requested if
+     * the ring buffer becomes empty.
+     */
+    std::size_t discardBytes(std::size_t count) {
+        count = count < getReadableByteCount() ? count
+                                               : getReadableByteCount();
+        _read += count;
+        return count;
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer without
+     * removing the bytes from the ring buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @return
+     * The number of bytes peeked.
+     *
+     * @note
+     * The number of bytes peeked may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t peekBytes(void *destination, std::size_t count) const {
+        assert(destination != nullptr);
+        return _peekBytes(destination, count, 0);
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer starting at a
+     * given offset in the ring buffer without removing the bytes from the ring
+     * buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @param[in] where
+     * The offset relative to the first byte in the ring buffer.
+     *
+     * @return
+     * The number of bytes peeked.
+     *
+     * @note
+     * The number of bytes peeked may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t peekBytesAt(void *destination, std::size_t count,
+                            std::size_t where) const {
+        assert(destination != nullptr);
+        return _peekBytes(destination, count, where);
+    }
+
+    /**
+     * Returns the free space in the ring buffer so that the client code can
+     * write into it directly.
+     *
+     * @see RingBuffer::reserveWrite()
+     */
+    SpanPair reserveWrite(std::size_t count);
+
+    /**
+     * Makes bytes that the client code wrote directly into the spans returned
+     * by reserveWrite() readable.
+     *
+     * @see RingBuffer::commitWrite()
+     */
+    void commitWrite(std::size_t count) {
+        assert(count <= getWritableByteCount());
+        _write += count;
+    }
+
+    /**
+     * Returns the readable bytes in the ring buffer so that the client code can
+     * inspect them in place.
+     *
+     * @see RingBuffer::readableSpans()
+     */
+    ConstSpanPair readableSpans() const;
+
+    /**
+     * Removes bytes that the client code inspected through the spans returned
+     * by readableSpans() from the ring buffer.
+     *
+     * @see RingBuffer::consume()
+     */
+    void consume(std::size_t count) {
+        assert(count <= getReadableByteCount());
+        _read += count;
+    }
+
+    /**
+     * Empties out the ring buffer.
+     */
+    void clear() { _read = _write; }
+
+private:
+    char *_buffer;        //!< The client-supplied buffer.
+    std::size_t _mask;    //!< The size of the buffer minus one.
+    std::uint64_t _read;  //!< Counts the bytes ever read.
+    std::uint64_t _write; //!< Counts the bytes ever written.
+
+    /**
+     * Copies bytes starting at a given offset from the first readable byte
+     * into a destination buffer.
+     *
+     * @return
+     * The number of bytes copied.
+     */
+    std::size_t _peekBytes(void *destination, std::size_t count,
+                           std::size_t where) const;
+    void _assertValid() const;
+}; // class PowerOfTwoRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_POWEROFTWORINGBUFFER_H
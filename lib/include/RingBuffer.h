@@ -31,11 +31,117 @@ SOFTWARE.
 #ifndef _HDC_RINGBUFFER_H
 #define _HDC_RINGBUFFER_H
 
+#include "CopyFunction.h"
+#include "Crc32c.h"
+#include "RingBufferStats.h"
+#include "Span.h"
+
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @def HDC_RINGBUFFER_ASSERT(condition)
+ * Checks a precondition or invariant of RingBuffer. Defaults to
+ * <tt>assert()</tt>. Define it to <tt>((void)0)</tt> before including
+ * RingBuffer.h to take the checks out of the hot path without defining
+ * @c NDEBUG for the whole program.
+ */
+#ifndef HDC_RINGBUFFER_ASSERT
+#define HDC_RINGBUFFER_ASSERT(condition) assert(condition)
+#endif
+
+/**
+ * @def HDC_RINGBUFFER_COPY(destination, source, count)
+ * Copies data in and out of a RingBuffer that has no copy function set.
+ * Defaults to <tt>std::memcpy()</tt>, through detail::copyBytes(). Define it
+ * before including RingBuffer.h to use a copy that suits the hardware, such
+ * as one made of aligned word accesses, without the indirect call
+ * setCopyFunction() costs.
+ */
+#ifndef HDC_RINGBUFFER_COPY
+#define HDC_RINGBUFFER_COPY(destination, source, count)                        \
+    ::hdc::ringbuffer::detail::copyBytes(destination, source, count)
+#endif
+
+/**
+ * @def HDC_RINGBUFFER_CONSTEXPR
+ * Marks the members of RingBuffer that can run at compile time, which takes
+ * C++14 relaxed @c constexpr. These are only the index bookkeeping: the
+ * array constructor, isEmpty(), isFull(), getReadableByteCount(),
+ * getWritableByteCount(), getDroppedByteCount(), isContiguous(), clear() and
+ * restore(). The transfers copy bytes, so they only run at run time.
+ */
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#define HDC_RINGBUFFER_CONSTEXPR constexpr
+#else
+#define HDC_RINGBUFFER_CONSTEXPR
+#endif
+
+/**
+ * @def HDC_RINGBUFFER_INLINE
+ * Marks the members of RingBuffer defined in RingBuffer.ipp, which are inline
+ * if @c HDC_RINGBUFFER_HEADER_ONLY is defined, as the
+ * @c RINGBUFFER_HEADER_ONLY CMake option does.
+ */
+#if defined(HDC_RINGBUFFER_HEADER_ONLY)
+#define HDC_RINGBUFFER_INLINE inline
+#else
+#define HDC_RINGBUFFER_INLINE
+#endif
 
 namespace hdc {
 namespace ringbuffer {
+namespace detail {
+
+/**
+ * Copies @p count bytes with <tt>std::memcpy()</tt>, the default
+ * @c HDC_RINGBUFFER_COPY.
+ *
+ * Once the transfers are inlined into the caller, as in the header-only
+ * build, GCC can bound the size of each piece of a transfer that wraps
+ * around, and expands the copy into a string instruction that is slow for
+ * short, unaligned pieces. So copies whose size is not known at compile time
+ * either move up to 16 bytes one at a time or call the library's
+ * @c memcpy().
+ */
+inline void copyBytes(void *destination, const void *source,
+                      std::size_t count) {
+#if defined(HDC_RINGBUFFER_HEADER_ONLY) && defined(__GNUC__)
+    if (!__builtin_constant_p(count)) {
+        if (count <= 16) {
+            auto to = static_cast<char *>(destination);
+            auto from = static_cast<const char *>(source);
+            for (std::size_t i = 0; i < count; ++i) {
+                to[i] = from[i];
+            }
+            return;
+        }
+        // Hide the bound on the size, so that the copy calls memcpy().
+        __asm__("" : "+r"(count));
+    }
+#endif
+    std::memcpy(destination, source, count);
+}
+
+/**
+ * Copies @p count bytes into @p spans, starting @p offset bytes in, with
+ * @c HDC_RINGBUFFER_COPY.
+ */
+HDC_RINGBUFFER_INLINE void copyToSpans(const SpanPair &spans,
+                                       std::size_t offset, const char *source,
+                                       std::size_t count);
+
+/**
+ * Copies @p count bytes out of @p spans, starting @p offset bytes in, with
+ * @c HDC_RINGBUFFER_COPY.
+ */
+HDC_RINGBUFFER_INLINE void copyFromSpans(const ConstSpanPair &spans,
+                                         std::size_t offset, char *destination,
+                                         std::size_t count);
+
+} // namespace detail
 
 /**
  * Ring buffer adapter.
@@ -43,7 +149,8 @@ namespace ringbuffer {
  * Adapts a client-supplied buffer into a ring buffer.
  *
  * @note
- * Uses <tt>std::memcpy()</tt> to copy data.
+ * Uses <tt>std::memcpy()</tt> to copy data, unless setCopyFunction() says
+ * otherwise.
  *
  * @warning
  * The client code must not reuse or delete the supplied buffer memory for the
@@ -54,6 +161,11 @@ namespace ringbuffer {
  */
 class RingBuffer {
 public:
+    /**
+     * Returned by findByte() and findBytes() if there is no match.
+     */
+    static const std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
     /**
      * Ring buffer constructor.
      *
@@ -62,17 +174,46 @@ public:
      *
      * @param[in] size
      * The size of the buffer in bytes.
+     *
+     * @param[in] mirrored
+     * Whether the @p size bytes following the buffer map the same memory as the
+     * buffer itself, as MirroredMemory does. If so, the ring buffer copies
+     * each region in one go, even if it wraps around the end of the buffer,
+     * and reserveWrite() and readableSpans() never split a region.
      */
-    RingBuffer(void *buffer, std::size_t size)
+    RingBuffer(void *buffer, std::size_t size, bool mirrored = false)
         : _buffer(static_cast<char *>(buffer)), _size(size), _read(size),
-          _write(0) {
+          _write(0), _mirrored(mirrored), _droppedByteCount(0),
+          _copyFunction(nullptr), _copyThreshold(0)
+#if defined(HDC_RINGBUFFER_STATS)
+          , _stats()
+#endif
+    {
+        _assertValid();
+    }
+
+    /**
+     * Ring buffer constructor for a fixed-size array, which, unlike the
+     * other constructor, can run at compile time.
+     *
+     * @param[in] buffer
+     * The array to adapt into a ring buffer.
+     */
+    template <std::size_t N>
+    HDC_RINGBUFFER_CONSTEXPR explicit RingBuffer(char (&buffer)[N])
+        : _buffer(buffer), _size(N), _read(N), _write(0), _mirrored(false),
+          _droppedByteCount(0), _copyFunction(nullptr), _copyThreshold(0)
+#if defined(HDC_RINGBUFFER_STATS)
+          , _stats()
+#endif
+    {
         _assertValid();
     }
 
     /**
      * Returns whether the ring buffer is empty.
      */
-    bool isEmpty() const {
+    HDC_RINGBUFFER_CONSTEXPR bool isEmpty() const {
         _assertValid();
         return _read == _size;
     }
@@ -80,7 +221,7 @@ public:
     /**
      * Returns whether the ring buffer is full.
      */
-    bool isFull() const {
+    HDC_RINGBUFFER_CONSTEXPR bool isFull() const {
         _assertValid();
         return _write == _size;
     }
@@ -88,17 +229,15 @@ public:
     /**
      * Returns the number of bytes that can be read from the ring buffer.
      */
-    std::size_t getReadableByteCount() const {
+    HDC_RINGBUFFER_CONSTEXPR std::size_t getReadableByteCount() const {
         _assertValid();
-        return isFull()         ? _size
-               : _read > _write ? _write + _size - _read
-                                : _write - _read;
+        return _getReadableByteCount(_read, _write);
     }
 
     /**
      * Returns the number of bytes that can be written to the ring buffer.
      */
-    ::size_t getWritableByteCount() const {
+    HDC_RINGBUFFER_CONSTEXPR std::size_t getWritableByteCount() const {
         _assertValid();
         return isFull()         ? 0
                : _read < _write ? _read + _size - _write
@@ -122,8 +261,38 @@ public:
      * ring buffer becomes empty.
      */
     std::size_t readBytes(void *destination, std::size_t count) {
-        assert(destination != nullptr);
-        return _readBytes(destination, count, _read, _write);
+        HDC_RINGBUFFER_ASSERT(destination != nullptr);
+        auto read = _readBytes(destination, count, _read, _write);
+        _countRead(read, read < count);
+        return read;
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer and updates
+     * a running CRC32C checksum with them in the same pass.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @param[in,out] crc
+     * The checksum to update, as for crc32c(). Start with 0.
+     *
+     * @return
+     * The number of bytes read.
+     *
+     * @note
+     * Copies with copyCrc32c() rather than any function set by
+     * setCopyFunction(), so each byte is read from the ring buffer once.
+     */
+    std::size_t readBytes(void *destination, std::size_t count,
+                          std::uint32_t &crc) {
+        HDC_RINGBUFFER_ASSERT(destination != nullptr);
+        auto read = _readBytes(destination, count, _read, _write, &crc);
+        _countRead(read, read < count);
+        return read;
     }
 
     /**
@@ -141,7 +310,163 @@ public:
      * The number of bytes written may be less than the number requested if the
      * ring buffer becomes full.
      */
-    std::size_t writeBytes(const void *source, std::size_t count);
+    std::size_t writeBytes(const void *source, std::size_t count) {
+        HDC_RINGBUFFER_ASSERT(source != nullptr);
+        auto start = _write;
+        auto written = _writeBytes(source, count);
+        _countWrite(start, written, written < count);
+        return written;
+    }
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer and updates a
+     * running CRC32C checksum with them in the same pass.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @param[in,out] crc
+     * The checksum to update, as for crc32c(). Start with 0.
+     *
+     * @return
+     * The number of bytes written. Only those bytes update the checksum.
+     *
+     * @note
+     * Copies with copyCrc32c() rather than any function set by
+     * setCopyFunction().
+     */
+    std::size_t writeBytes(const void *source, std::size_t count,
+                           std::uint32_t &crc) {
+        HDC_RINGBUFFER_ASSERT(source != nullptr);
+        auto start = _write;
+        auto written = _writeBytes(source, count, &crc);
+        _countWrite(start, written, written < count);
+        return written;
+    }
+
+    /**
+     * Writes messages from a gather list into the ring buffer.
+     *
+     * Writes each message in turn, stopping at the first one that does not
+     * fit in its entirety, and updates the ring buffer state once for the
+     * whole batch.
+     *
+     * @param[in] messages
+     * The messages to write.
+     *
+     * @param[in] count
+     * The number of messages.
+     *
+     * @return
+     * The number of messages written.
+     *
+     * @note
+     * The number of messages written may be less than the number requested if
+     * the ring buffer becomes full. A message is never written in part.
+     */
+    std::size_t writeBatch(const ConstSpan *messages, std::size_t count);
+
+    /**
+     * Reads messages from the ring buffer into a scatter list.
+     *
+     * Fills each destination in turn, stopping at the first one that the
+     * readable bytes cannot fill in its entirety, and updates the ring buffer
+     * state once for the whole batch.
+     *
+     * @param[out] messages
+     * The destinations to fill.
+     *
+     * @param[in] count
+     * The number of destinations.
+     *
+     * @return
+     * The number of destinations filled.
+     *
+     * @note
+     * The number of destinations filled may be less than the number requested
+     * if the ring buffer becomes empty. A destination is never filled in part.
+     */
+    std::size_t readBatch(const Span *messages, std::size_t count);
+
+    /**
+     * Returns the free space in the ring buffer so that the client code can
+     * write into it directly.
+     *
+     * @param[in] count
+     * The maximum number of bytes to return.
+     *
+     * @return
+     * Up to @p count writable bytes, starting at the next byte to write.
+     *
+     * @note
+     * The returned spans hold fewer than @p count bytes if the ring buffer
+     * does not have that much free space.
+     *
+     * @note
+     * The bytes do not become readable until the client code calls
+     * commitWrite(). Any other operation that modifies the ring buffer
+     * invalidates the returned spans.
+     */
+    SpanPair reserveWrite(std::size_t count);
+
+    /**
+     * Makes bytes that the client code wrote directly into the spans returned
+     * by reserveWrite() readable.
+     *
+     * @param[in] count
+     * The number of bytes to commit. Must not exceed the number of writable
+     * bytes.
+     */
+    void commitWrite(std::size_t count) {
+        HDC_RINGBUFFER_ASSERT(count <= getWritableByteCount());
+        auto start = _write;
+        _writeBytes(nullptr, count);
+        _countWrite(start, count, false);
+    }
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer, discarding the
+     * oldest bytes in the ring buffer to make room if needed.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return
+     * The number of bytes dropped to make room.
+     *
+     * @note
+     * Always succeeds. If @p count exceeds the size of the buffer, only the
+     * last bytes of the source buffer are written and the rest count as
+     * dropped.
+     */
+    std::size_t overwriteBytes(const void *source, std::size_t count);
+
+    /**
+     * Returns the total number of bytes that overwriteBytes() has dropped.
+     */
+    HDC_RINGBUFFER_CONSTEXPR std::uint64_t getDroppedByteCount() const {
+        return _droppedByteCount;
+    }
+
+    /**
+     * Returns a snapshot of the usage statistics.
+     *
+     * @note
+     * All zero unless built with @c HDC_RINGBUFFER_STATS. See RingBufferStats.
+     */
+    RingBufferStats getStats() const {
+#if defined(HDC_RINGBUFFER_STATS)
+        return _stats;
+#else
+        return RingBufferStats();
+#endif
+    }
 
     /**
      * Discards bytes from the ring buffer.
@@ -157,7 +482,9 @@ public:
      * the ring buffer becomes empty.
      */
     std::size_t discardBytes(std::size_t count) {
-        return _readBytes(nullptr, count, _read, _write);
+        auto discarded = _readBytes(nullptr, count, _read, _write);
+        _countRead(discarded, discarded < count);
+        return discarded;
     }
 
     /**
@@ -178,12 +505,37 @@ public:
      * ring buffer becomes empty.
      */
     std::size_t peekBytes(void *destination, std::size_t count) {
-        assert(destination != nullptr);
+        HDC_RINGBUFFER_ASSERT(destination != nullptr);
         auto read = _read;
         auto write = _write;
         return _readBytes(destination, count, read, write);
     }
 
+    /**
+     * Reads bytes from the ring buffer into a destination buffer without
+     * removing them, and updates a running CRC32C checksum with them in the
+     * same pass.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @param[in,out] crc
+     * The checksum to update, as for crc32c(). Start with 0.
+     *
+     * @return
+     * The number of bytes peeked.
+     */
+    std::size_t peekBytes(void *destination, std::size_t count,
+                          std::uint32_t &crc) {
+        HDC_RINGBUFFER_ASSERT(destination != nullptr);
+        auto read = _read;
+        auto write = _write;
+        return _readBytes(destination, count, read, write, &crc);
+    }
+
     /**
      * Reads bytes from the ring buffer into a destination buffer starting at a
      * given offset in the ring buffer without removing the bytes from the ring
@@ -207,7 +559,7 @@ public:
      */
     std::size_t peekBytesAt(void *destination, std::size_t count,
                             std::size_t where) {
-        assert(destination != nullptr);
+        HDC_RINGBUFFER_ASSERT(destination != nullptr);
         auto read = _read;
         auto write = _write;
         if (_readBytes(nullptr, where, read, write) != where) {
@@ -216,14 +568,200 @@ public:
         return _readBytes(destination, count, read, write);
     }
 
+    /**
+     * Returns the readable bytes in the ring buffer so that the client code can
+     * inspect them in place.
+     *
+     * @return
+     * All readable bytes, starting at the next byte to read.
+     *
+     * @note
+     * Any operation that modifies the ring buffer invalidates the returned
+     * spans.
+     */
+    ConstSpanPair readableSpans() const;
+
+    /**
+     * Returns whether the readable bytes are contiguous, so that
+     * readableSpans() returns them in its first span alone.
+     *
+     * @note
+     * Always @c true for an empty or mirrored ring buffer.
+     */
+    HDC_RINGBUFFER_CONSTEXPR bool isContiguous() const {
+        _assertValid();
+        return _mirrored ||
+               (_write == _size ? _read == 0 : _read < _write || _write == 0);
+    }
+
+    /**
+     * Moves the readable bytes in place to the beginning of the buffer, so
+     * that they are contiguous and so is the free space after them.
+     *
+     * Rotates the data within the buffer, without a temporary copy, in time
+     * proportional to the number of readable bytes. Meant for the rare case in
+     * which a parser needs contiguous bytes and isContiguous() returns
+     * @c false.
+     *
+     * @return
+     * All readable bytes, starting at the beginning of the buffer.
+     *
+     * @note
+     * Invalidates any spans returned by readableSpans() or reserveWrite().
+     */
+    ConstSpan linearize();
+
+    /**
+     * Moves the ring buffer to a different buffer, keeping the readable bytes.
+     *
+     * Copies the readable bytes to the beginning of the new buffer in at most
+     * two copies, with the function set by setCopyFunction() if any, and
+     * leaves the free space after them contiguous. Meant for growing a ring
+     * buffer on demand without draining it first, as GrowableRingBuffer
+     * does.
+     *
+     * @param[in] buffer
+     * The new buffer. Must not overlap the current one.
+     *
+     * @param[in] size
+     * The size of the new buffer in bytes. Must be at least the number of
+     * readable bytes.
+     *
+     * @param[in] mirrored
+     * Whether the new buffer is mirrored, as for the constructor.
+     *
+     * @note
+     * Invalidates any spans returned by readableSpans() or reserveWrite().
+     * The client code may reuse or delete the old buffer once this returns.
+     */
+    void resize(void *buffer, std::size_t size, bool mirrored = false);
+
+    /**
+     * Removes bytes that the client code inspected through the spans returned
+     * by readableSpans() from the ring buffer.
+     *
+     * @param[in] count
+     * The number of bytes to consume. Must not exceed the number of readable
+     * bytes.
+     */
+    void consume(std::size_t count) {
+        HDC_RINGBUFFER_ASSERT(count <= getReadableByteCount());
+        _readBytes(nullptr, count, _read, _write);
+        _countRead(count, false);
+    }
+
+    /**
+     * Finds a byte in the readable bytes of the ring buffer without copying
+     * them.
+     *
+     * @param[in] value
+     * The byte to find.
+     *
+     * @param[in] from
+     * The offset, relative to the first byte in the ring buffer, at which to
+     * start searching.
+     *
+     * @return
+     * The offset of the first matching byte at or after @p from, relative to
+     * the first byte in the ring buffer, or @ref NOT_FOUND.
+     *
+     * @note
+     * The offset can be passed to peekBytesAt() or used to size a
+     * readBytes() or discardBytes() call.
+     */
+    std::size_t findByte(std::uint8_t value, std::size_t from = 0) const;
+
+    /**
+     * Finds a sequence of bytes, such as a delimiter, in the readable bytes of
+     * the ring buffer without copying them.
+     *
+     * @param[in] pattern
+     * The bytes to find.
+     *
+     * @param[in] size
+     * The number of bytes to find. Must not be 0.
+     *
+     * @param[in] from
+     * The offset, relative to the first byte in the ring buffer, at which to
+     * start searching.
+     *
+     * @return
+     * The offset of the first byte of the first match at or after @p from,
+     * relative to the first byte in the ring buffer, or @ref NOT_FOUND. A
+     * match may wrap around the end of the buffer.
+     */
+    std::size_t findBytes(const void *pattern, std::size_t size,
+                          std::size_t from = 0) const;
+
+    /**
+     * Sets the function that copies data into and out of the ring buffer.
+     *
+     * @param[in] copy
+     * The copy function, such as nonTemporalCopy() or a hook that hands the
+     * copy to a DMA engine, or @c nullptr for <tt>std::memcpy()</tt>.
+     *
+     * @param[in] threshold
+     * The smallest copy, in bytes, to use @p copy for. Smaller copies use
+     * <tt>std::memcpy()</tt>.
+     *
+     * @note
+     * Applies to readBytes(), writeBytes(), peekBytes(), peekBytesAt() and
+     * overwriteBytes(). A data region that wraps around the end of the buffer
+     * is copied in two parts, each compared against @p threshold separately.
+     * writeBatch() and readBatch(), which are meant for small messages, always
+     * use <tt>std::memcpy()</tt>.
+     *
+     * @note
+     * To choose the copy function for a single call, set it before the call
+     * and restore it afterwards. Setting it is cheap.
+     */
+    void setCopyFunction(CopyFunction copy, std::size_t threshold = 0) {
+        _copyFunction = copy;
+        _copyThreshold = threshold;
+    }
+
+    /**
+     * Returns the function set by setCopyFunction(), or @c nullptr if the ring
+     * buffer uses <tt>std::memcpy()</tt>.
+     */
+    CopyFunction getCopyFunction() const { return _copyFunction; }
+
     /**
      * Empties out the ring buffer.
      */
-    void clear() {
+    HDC_RINGBUFFER_CONSTEXPR void clear() {
         _read = _size;
         _write = 0;
     }
 
+    /**
+     * Makes bytes already in the buffer readable, in place of the current
+     * contents, as when reattaching to a buffer that outlived an earlier ring
+     * buffer.
+     *
+     * @param[in] offset
+     * The offset in the buffer of the first readable byte. Must be less than
+     * the size of the buffer.
+     *
+     * @param[in] count
+     * The number of readable bytes, which may wrap around the end of the
+     * buffer. Must not exceed the size of the buffer.
+     */
+    HDC_RINGBUFFER_CONSTEXPR void restore(std::size_t offset,
+                                          std::size_t count) {
+        _assertValid();
+        HDC_RINGBUFFER_ASSERT(offset < _size);
+        HDC_RINGBUFFER_ASSERT(count <= _size);
+        if (count == 0) {
+            clear();
+            return;
+        }
+        _read = offset;
+        _write = count == _size ? _size
+                 : count < _size - offset ? offset + count
+                                          : offset + count - _size;
+    }
+
 private:
     char *_buffer;      //!< The client-supplied buffer.
     std::size_t _size;  //!< The size of the buffer.
@@ -231,6 +769,81 @@ private:
                         //!< buffer empty.
     std::size_t _write; //!< Indexes the next byte to write. Set to _size when
                         //!< buffer full. Set to 0 when buffer empty.
+    bool _mirrored;     //!< Whether the buffer is followed by a mirror of
+                        //!< itself.
+
+    std::uint64_t _droppedByteCount; //!< Bytes lost to overwriteBytes().
+    CopyFunction _copyFunction;      //!< Copies data, or nullptr for memcpy.
+    std::size_t _copyThreshold;      //!< The smallest copy for _copyFunction.
+#if defined(HDC_RINGBUFFER_STATS)
+    RingBufferStats _stats; //!< The usage statistics.
+#endif
+
+    /**
+     * Returns the number of readable bytes given the read and write indexes.
+     */
+    HDC_RINGBUFFER_CONSTEXPR std::size_t
+    _getReadableByteCount(std::size_t read, std::size_t write) const {
+        return write == _size ? _size
+               : read > write ? write + _size - read
+                              : write - read;
+    }
+
+    /**
+     * Updates the statistics after a write that started at write index
+     * @p start and wrote @p written bytes, which was short if @p isShort.
+     */
+    void _countWrite(std::size_t start, std::size_t written, bool isShort) {
+#if defined(HDC_RINGBUFFER_STATS)
+        _stats.bytesWritten += written;
+        _stats.shortWrites += isShort ? 1 : 0;
+        if (written != 0) {
+            _stats.fullCount += isFull() ? 1 : 0;
+            _stats.wrapCount += start + written >= _size ? 1 : 0;
+            auto readable = getReadableByteCount();
+            if (readable > _stats.peakReadableBytes) {
+                _stats.peakReadableBytes = readable;
+            }
+        }
+#else
+        (void)start;
+        (void)written;
+        (void)isShort;
+#endif
+    }
+
+    /**
+     * Updates the statistics after a read or discard of @p read bytes, which
+     * was short if @p isShort.
+     */
+    void _countRead(std::size_t read, bool isShort) {
+#if defined(HDC_RINGBUFFER_STATS)
+        _stats.bytesRead += read;
+        _stats.shortReads += isShort ? 1 : 0;
+        if (read != 0) {
+            _stats.emptyCount += isEmpty() ? 1 : 0;
+        }
+#else
+        (void)read;
+        (void)isShort;
+#endif
+    }
+
+    /**
+     * Copies bytes, updating @p crc on the way if it is not @c nullptr, with
+     * the copy function if one is set and the copy is large enough, and with
+     * <tt>std::memcpy()</tt> otherwise.
+     */
+    void _copy(void *destination, const void *source, std::size_t count,
+               std::uint32_t *crc) const {
+        if (crc != nullptr) {
+            *crc = copyCrc32c(destination, source, count, *crc);
+        } else if (_copyFunction != nullptr && count >= _copyThreshold) {
+            _copyFunction(destination, source, count);
+        } else {
+            HDC_RINGBUFFER_COPY(destination, source, count);
+        }
+    }
 
     /**
      * Reads bytes from the ring buffer into a destination buffer or discards
@@ -248,6 +861,9 @@ private:
      * @param[in,out] write
      * The index of the next byte to write.
      *
+     * @param[in,out] crc
+     * The checksum to update with the bytes read, or @c nullptr.
+     *
      * @return
      * The number of bytes read or discarded.
      *
@@ -256,11 +872,47 @@ private:
      * requested if the ring buffer becomes empty.
      */
     std::size_t _readBytes(void *destination, std::size_t count,
-                           std::size_t &read, std::size_t &write);
-    void _assertValid() const;
+                           std::size_t &read, std::size_t &write,
+                           std::uint32_t *crc = nullptr);
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer or commits bytes
+     * already written into the ring buffer if no source buffer is provided.
+     *
+     * @param[in] source
+     * The source buffer to write from or @c nullptr to commit.
+     *
+     * @param[in] count
+     * The number of bytes to write or commit.
+     *
+     * @param[in,out] crc
+     * The checksum to update with the bytes written, or @c nullptr.
+     *
+     * @return
+     * The number of bytes written or committed.
+     *
+     * @note
+     * The number of bytes written or committed may be less than the number
+     * requested if the ring buffer becomes full.
+     */
+    std::size_t _writeBytes(const void *source, std::size_t count,
+                            std::uint32_t *crc = nullptr);
+
+    HDC_RINGBUFFER_CONSTEXPR void _assertValid() const {
+        HDC_RINGBUFFER_ASSERT(_buffer != nullptr);
+        HDC_RINGBUFFER_ASSERT(_size > 0);
+        HDC_RINGBUFFER_ASSERT(_read < _size ||
+                              (_read == _size && _write == 0));
+        HDC_RINGBUFFER_ASSERT(_write <= _size);
+        HDC_RINGBUFFER_ASSERT(_read != _write);
+    }
 }; // class RingBuffer
 
 } // namespace ringbuffer
 } // namespace hdc
 
+#if defined(HDC_RINGBUFFER_HEADER_ONLY)
+#include "RingBuffer.ipp"
+#endif
+
 #endif // _HDC_RINGBUFFER_H
\ No newline at end of file
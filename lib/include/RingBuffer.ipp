@@ -0,0 +1,483 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Defines the members of class RingBuffer that a header-only build inlines.
+ *
+ * Included by RingBuffer.h if @c HDC_RINGBUFFER_HEADER_ONLY is defined, and by
+ * RingBuffer.cpp otherwise.
+ */
+
+#ifndef _HDC_RINGBUFFER_IPP
+#define _HDC_RINGBUFFER_IPP
+
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace hdc {
+namespace ringbuffer {
+namespace detail {
+
+HDC_RINGBUFFER_INLINE void copyToSpans(const SpanPair &spans,
+                                       std::size_t offset, const char *source,
+                                       std::size_t count) {
+    if (offset < spans.first.size) {
+        auto n = std::min(count, spans.first.size - offset);
+        HDC_RINGBUFFER_COPY(spans.first.data + offset, source, n);
+        if (n == count) {
+            return;
+        }
+        source += n;
+        count -= n;
+        offset = spans.first.size;
+    }
+    HDC_RINGBUFFER_COPY(spans.second.data + (offset - spans.first.size),
+                        source, count);
+}
+
+HDC_RINGBUFFER_INLINE void copyFromSpans(const ConstSpanPair &spans,
+                                         std::size_t offset, char *destination,
+                                         std::size_t count) {
+    if (offset < spans.first.size) {
+        auto n = std::min(count, spans.first.size - offset);
+        HDC_RINGBUFFER_COPY(destination, spans.first.data + offset, n);
+        if (n == count) {
+            return;
+        }
+        destination += n;
+        count -= n;
+        offset = spans.first.size;
+    }
+    HDC_RINGBUFFER_COPY(destination,
+                        spans.second.data + (offset - spans.first.size), count);
+}
+
+} // namespace detail
+
+HDC_RINGBUFFER_INLINE std::size_t
+RingBuffer::writeBatch(const ConstSpan *messages, std::size_t count) {
+    HDC_RINGBUFFER_ASSERT(messages != nullptr || count == 0);
+
+    // Look up the free space once, fill it message by message, then commit
+    // the whole batch.
+    auto spans = reserveWrite(getWritableByteCount());
+    auto writable = spans.size();
+    std::size_t written = 0;
+    std::size_t i = 0;
+    for (; i < count && messages[i].size <= writable - written; ++i) {
+        HDC_RINGBUFFER_ASSERT(messages[i].data != nullptr);
+        detail::copyToSpans(spans, written, messages[i].data, messages[i].size);
+        written += messages[i].size;
+    }
+    auto start = _write;
+    _writeBytes(nullptr, written);
+    _countWrite(start, written, i < count);
+    return i;
+}
+
+HDC_RINGBUFFER_INLINE std::size_t RingBuffer::readBatch(const Span *messages,
+                                                        std::size_t count) {
+    HDC_RINGBUFFER_ASSERT(messages != nullptr || count == 0);
+
+    // Look up the readable bytes once, drain them message by message, then
+    // consume the whole batch.
+    auto spans = readableSpans();
+    auto readable = spans.size();
+    std::size_t read = 0;
+    std::size_t i = 0;
+    for (; i < count && messages[i].size <= readable - read; ++i) {
+        HDC_RINGBUFFER_ASSERT(messages[i].data != nullptr);
+        detail::copyFromSpans(spans, read, messages[i].data, messages[i].size);
+        read += messages[i].size;
+    }
+    _readBytes(nullptr, read, _read, _write);
+    _countRead(read, i < count);
+    return i;
+}
+
+HDC_RINGBUFFER_INLINE std::size_t
+RingBuffer::overwriteBytes(const void *source, std::size_t count) {
+    HDC_RINGBUFFER_ASSERT(source != nullptr);
+
+    std::size_t dropped = 0;
+    if (count > _size) {
+        // The start of the source would be overwritten by its own end.
+        dropped = count - _size;
+        source = static_cast<const char *>(source) + dropped;
+        count = _size;
+    }
+    auto writable = getWritableByteCount();
+    if (writable < count) {
+        dropped += _readBytes(nullptr, count - writable, _read, _write);
+    }
+    _droppedByteCount += dropped;
+
+    auto start = _write;
+    auto written = _writeBytes(source, count);
+    HDC_RINGBUFFER_ASSERT(written == count);
+    _countWrite(start, written, false);
+    return dropped;
+}
+
+HDC_RINGBUFFER_INLINE SpanPair RingBuffer::reserveWrite(std::size_t count) {
+    _assertValid();
+
+    SpanPair spans = {{_buffer + _write, 0}, {_buffer, 0}};
+    if (isFull()) {
+        return spans;
+    }
+
+    if (_mirrored) {
+        // The mirror makes the free space contiguous.
+        spans.first.size = std::min(count, getWritableByteCount());
+    } else if (_read < _write) {
+        // Non-Full, Read Beginning or Wrap Write: free space runs from _write
+        // up to end of buffer, then from beginning of buffer up to _read.
+        spans.first.size = std::min(count, _size - _write);
+        spans.second.size = std::min(count - spans.first.size, _read);
+    } else {
+        // Empty, Non-Empty, Write Beginning or Non-Full, Wrap Read: free space
+        // runs from _write up to _read.
+        spans.first.size = std::min(count, _read - _write);
+    }
+    return spans;
+}
+
+HDC_RINGBUFFER_INLINE ConstSpanPair RingBuffer::readableSpans() const {
+    _assertValid();
+
+    ConstSpanPair spans = {{_buffer, 0}, {_buffer, 0}};
+    if (isEmpty()) {
+        return spans;
+    }
+
+    spans.first.data = _buffer + _read;
+    if (_mirrored) {
+        // The mirror makes the data contiguous.
+        spans.first.size = getReadableByteCount();
+    } else if (_read > _write || _write == _size) {
+        // Full, Read Beginning, Full, Read Middle, Non-Empty, Write Beginning
+        // or Non-Full, Wrap Read: data runs from _read up to end of buffer,
+        // then from beginning of buffer up to _write, or up to _read if the
+        // buffer is full.
+        spans.first.size = _size - _read;
+        spans.second.size = _write == _size ? _read : _write;
+    } else {
+        // Non-Full, Read Beginning or Wrap Write: data runs from _read up to
+        // _write.
+        spans.first.size = _write - _read;
+    }
+    return spans;
+}
+
+HDC_RINGBUFFER_INLINE ConstSpan RingBuffer::linearize() {
+    _assertValid();
+
+    ConstSpan span = {_buffer, getReadableByteCount()};
+    if (span.size == 0) {
+        return span;
+    }
+
+    if (_read > _write || _write == _size) {
+        // Full, Read Beginning, Full, Read Middle, Non-Empty, Write Beginning
+        // or Non-Full, Wrap Read: the head of the data runs from _read up to
+        // end of buffer, and the tail from beginning of buffer up to _write,
+        // or up to _read if the buffer is full. Close the gap between them,
+        // then rotate the tail after the head.
+        auto tail = _write == _size ? _read : _write;
+        auto head = _size - _read;
+        std::memmove(_buffer + tail, _buffer + _read, head);
+        std::rotate(_buffer, _buffer + tail, _buffer + tail + head);
+    } else {
+        // Non-Full, Read Beginning or Wrap Write: the data runs from _read up
+        // to _write.
+        std::memmove(_buffer, _buffer + _read, span.size);
+    }
+
+    _read = 0;
+    if (_write != _size) {
+        _write = span.size;
+    }
+    return span;
+}
+
+HDC_RINGBUFFER_INLINE void RingBuffer::resize(void *buffer, std::size_t size,
+                                              bool mirrored) {
+    _assertValid();
+
+    auto count = getReadableByteCount();
+    HDC_RINGBUFFER_ASSERT(size >= count);
+    HDC_RINGBUFFER_ASSERT(static_cast<char *>(buffer) + size <= _buffer ||
+                          _buffer + _size <= static_cast<char *>(buffer));
+
+    // Copy as a peek would, so that wrapped data costs two copies, or one if
+    // the old buffer is mirrored.
+    auto read = _read;
+    auto write = _write;
+    auto copied = _readBytes(buffer, count, read, write);
+    HDC_RINGBUFFER_ASSERT(copied == count);
+    (void)copied;
+
+    _buffer = static_cast<char *>(buffer);
+    _size = size;
+    _mirrored = mirrored;
+    _read = count == 0 ? size : 0;
+    _write = count == size ? size : count;
+    _assertValid();
+}
+
+HDC_RINGBUFFER_INLINE std::size_t RingBuffer::_writeBytes(const void *source,
+                                                          std::size_t count,
+                                                          std::uint32_t *crc) {
+    _assertValid();
+
+    if (count == 0 || isFull()) {
+        return 0;
+    }
+
+    if (_mirrored && source != nullptr) {
+        // The mirror makes the free space contiguous. Copy in one go, then
+        // update the indexes as a commit would.
+        auto n = std::min(count, getWritableByteCount());
+        _copy(_buffer + _write, source, n, crc);
+        return _writeBytes(nullptr, n);
+    }
+
+    auto original_count = count;
+
+    if (_read < _write) {
+        // clang-format off
+        // The following states are possible here:
+        //   Non-Full, Read Beginning
+        //         0                                    _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+
+        //     | First |  ...  | Last  | Empty |  ...  | Empty |
+        //     +-------+-------+-------+-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //       _read                  _write
+        //   Wrap Write
+        //         0                                                            _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //     | Empty |  ...  | Empty | First |  ...  | Last  | Empty |  ...  | Empty |
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //                                 ^                       ^
+        //                                 |                       |
+        //                               _read                  _write
+        // clang-format on
+
+        // Write up to count bytes up to end of buffer.
+        auto n = std::min(count, _size - _write);
+        if (source != nullptr) {
+            _copy(_buffer + _write, source, n, crc);
+            source = static_cast<const char *>(source) + n;
+        }
+        count -= n;
+        _write += n;
+
+        // Wrap around if buffer not full.
+        if (_write == _size && _read > 0) {
+            _write = 0;
+        }
+    }
+
+    if (_read > _write) {
+        // clang-format off
+        // The following states are possible here:
+        //   Empty:
+        //         0            _size-1  _size
+        //     +-------+-------+-------+
+        //     | Empty |  ...  | Empty |
+        //     +-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //      _write                   _read
+        //   Non-Empty, Write Beginning:
+        //         0                                    _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+
+        //     | Empty |  ...  | Empty | First |  ...  | Last  |
+        //     +-------+-------+-------+-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //      _write                   _read
+        //   Non-Full, Wrap Read:
+        //       0                                                              _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //     | Valid |  ...  | Last  | Empty |  ...  | Empty | First |  ...  | Valid |
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //                                 ^                       ^
+        //                                 |                       |
+        //                              _write                   _read
+        // clang-format on
+
+        // Write up to count bytes up to read location.
+        auto n = std::min(count, _read - _write);
+        if (source != nullptr) {
+            _copy(_buffer + _write, source, n, crc);
+        }
+        _write += n;
+        count -= n;
+
+        if (_write == _read) {
+            // Buffer full.
+            _write = _size;
+        }
+
+        if (_read == _size) {
+            // Buffer was empty.
+            // We've just written to beginning of buffer.
+            // Make next read() start at beginning of buffer.
+            _read = 0;
+        }
+    }
+
+    return original_count - count;
+}
+
+HDC_RINGBUFFER_INLINE std::size_t RingBuffer::_readBytes(void *destination,
+                                                         std::size_t count,
+                                                         std::size_t &read,
+                                                         std::size_t &write,
+                                                         std::uint32_t *crc) {
+    _assertValid();
+
+    if (count == 0 || isEmpty()) {
+        return 0;
+    }
+
+    if (_mirrored && destination != nullptr) {
+        // The mirror makes the data contiguous. Copy in one go, then update
+        // the indexes as a discard would.
+        auto n = std::min(count, _getReadableByteCount(read, write));
+        _copy(destination, _buffer + read, n, crc);
+        return _readBytes(nullptr, n, read, write);
+    }
+
+    auto original_count = count;
+
+    if (read > write || write == _size) {
+        // clang-format off
+        // The following states are possible here:
+        //   Full, Read Beginning:
+        //         0            _size-1  _size
+        //     +-------+-------+-------+
+        //     | First |  ...  | Last  |
+        //     +-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //       read                    write
+        //   Full, Read Middle:
+        //         0                                    _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+
+        //     | Valid |  ...  | Last  | First |  ...  | Valid |
+        //     +-------+-------+-------+-------+-------+-------+
+        //                                 ^                       ^
+        //                                 |                       |
+        //                               read                    write
+        //   Non-Empty, Write Beginning:
+        //         0                                    _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+
+        //     | Empty |  ...  | Empty | First |  ...  | Last  |
+        //     +-------+-------+-------+-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //       write                   read
+        //   Non-Full, Wrap Read:
+        //       0                                                              _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //     | Valid |  ...  | Last  | Empty |  ...  | Empty | First |  ...  | Valid |
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //                                 ^                       ^
+        //                                 |                       |
+        //                               write                   read
+        // clang-format on
+
+        if (write == _size) {
+            // Buffer full.
+            // Reading will free up space for writing.
+            // Make next write() start at current read location.
+            write = read;
+        }
+
+        // Read up to count bytes up to end of buffer.
+        auto n = std::min(count, _size - read);
+        if (destination != nullptr) {
+            _copy(destination, _buffer + read, n, crc);
+            destination = static_cast<char *>(destination) + n;
+        }
+        count -= n;
+        read += n;
+
+        // Wrap around reading if buffer not empty.
+        if (read == _size && write > 0) {
+            read = 0;
+        }
+    }
+
+    if (read < write) {
+        // clang-format off
+        // The following states are possible here:
+        //   Non-Full, Read Beginning
+        //        0                                    _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+
+        //     | First |  ...  | Last  | Empty |  ...  | Empty |
+        //     +-------+-------+-------+-------+-------+-------+
+        //         ^                       ^
+        //         |                       |
+        //       read                    write
+        //   Wrap Write
+        //         0                                                            _size-1  _size
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //     | Empty |  ...  | Empty | First |  ...  | Last  | Empty |  ...  | Empty |
+        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
+        //                                 ^                       ^
+        //                                 |                       |
+        //                               read                    write
+        // clang-format on
+
+        // Read up to count bytes up to write location.
+        auto n = std::min(count, write - read);
+        if (destination != nullptr) {
+            _copy(destination, _buffer + read, n, crc);
+        }
+        count -= n;
+        read += n;
+
+        if (read == write) {
+            // Buffer empty.
+            read = _size;
+            write = 0;
+        }
+    }
+
+    return original_count - count;
+}
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFER_IPP
@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares functions that move data between a RingBuffer and a POSIX file
+ * descriptor without intermediate copies.
+ *
+ * Each function builds an @c iovec array from the ring buffer's free or
+ * readable spans and transfers both halves of a wrapping region with a single
+ * system call.
+ *
+ * @note
+ * Only available on POSIX systems.
+ */
+
+#ifndef _HDC_RINGBUFFERIO_H
+#define _HDC_RINGBUFFERIO_H
+
+#include "RingBuffer.h"
+
+#include <cstddef>
+
+#include <sys/types.h>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Reads from a file descriptor into the ring buffer with @c readv().
+ *
+ * @param[in,out] ringBuffer
+ * The ring buffer to write into.
+ *
+ * @param[in] fd
+ * The file descriptor to read from.
+ *
+ * @param[in] max
+ * The maximum number of bytes to read.
+ *
+ * @return
+ * The number of bytes read, 0 at end of file or if the ring buffer is full,
+ * or -1 with @c errno set on error.
+ *
+ * @note
+ * The ring buffer is unchanged on error.
+ */
+ssize_t readFromFd(RingBuffer &ringBuffer, int fd, std::size_t max);
+
+/**
+ * Writes from the ring buffer to a file descriptor with @c writev().
+ *
+ * @param[in,out] ringBuffer
+ * The ring buffer to read from.
+ *
+ * @param[in] fd
+ * The file descriptor to write to.
+ *
+ * @param[in] max
+ * The maximum number of bytes to write.
+ *
+ * @return
+ * The number of bytes written, 0 if the ring buffer is empty, or -1 with
+ * @c errno set on error.
+ *
+ * @note
+ * Only the bytes written are removed from the ring buffer.
+ */
+ssize_t writeToFd(RingBuffer &ringBuffer, int fd, std::size_t max);
+
+/**
+ * Receives from a socket into the ring buffer with @c recvmsg().
+ *
+ * @param[in,out] ringBuffer
+ * The ring buffer to write into.
+ *
+ * @param[in] fd
+ * The socket to receive from.
+ *
+ * @param[in] max
+ * The maximum number of bytes to receive.
+ *
+ * @param[in] flags
+ * The flags to pass to @c recvmsg(), such as @c MSG_DONTWAIT.
+ *
+ * @return
+ * The number of bytes received, 0 on orderly shutdown or if the ring buffer is
+ * full, or -1 with @c errno set on error.
+ */
+ssize_t receiveFromSocket(RingBuffer &ringBuffer, int fd, std::size_t max,
+                          int flags);
+
+/**
+ * Sends from the ring buffer to a socket with @c sendmsg().
+ *
+ * @param[in,out] ringBuffer
+ * The ring buffer to read from.
+ *
+ * @param[in] fd
+ * The socket to send to.
+ *
+ * @param[in] max
+ * The maximum number of bytes to send.
+ *
+ * @param[in] flags
+ * The flags to pass to @c sendmsg(), such as @c MSG_NOSIGNAL.
+ *
+ * @return
+ * The number of bytes sent, 0 if the ring buffer is empty, or -1 with
+ * @c errno set on error.
+ */
+ssize_t sendToSocket(RingBuffer &ringBuffer, int fd, std::size_t max,
+                     int flags);
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFERIO_H
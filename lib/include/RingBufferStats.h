@@ -0,0 +1,72 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Declares struct RingBufferStats.
+ */
+
+#ifndef _HDC_RINGBUFFERSTATS_H
+#define _HDC_RINGBUFFERSTATS_H
+
+#include <cstdint>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * A snapshot of a ring buffer's usage statistics.
+ *
+ * The ring buffers only keep statistics if the library and the client code
+ * are built with @c HDC_RINGBUFFER_STATS defined, which the
+ * @c RINGBUFFER_STATS CMake option does. Otherwise, the statistics are
+ * compiled out and every field of the snapshot is zero.
+ *
+ * A write or read that transfers fewer bytes than requested, including none,
+ * counts as short. Peeks do not count as reads.
+ */
+struct RingBufferStats {
+    /** Whether the statistics are kept at all. */
+    static constexpr bool ENABLED =
+#if defined(HDC_RINGBUFFER_STATS)
+        true;
+#else
+        false;
+#endif
+
+    std::uint64_t bytesWritten; //!< Total bytes written.
+    std::uint64_t bytesRead;    //!< Total bytes read or discarded.
+    std::uint64_t shortWrites;  //!< Writes that fell short.
+    std::uint64_t shortReads;   //!< Reads and discards that fell short.
+    std::uint64_t fullCount;    //!< Times a write filled the ring buffer.
+    std::uint64_t emptyCount;   //!< Times a read emptied the ring buffer.
+    std::uint64_t wrapCount; //!< Writes that reached the end of the buffer.
+    std::uint64_t peakReadableBytes; //!< The most bytes ever readable.
+};
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFERSTATS_H
@@ -0,0 +1,177 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class RingBufferStorage.
+ */
+
+#ifndef _HDC_RINGBUFFERSTORAGE_H
+#define _HDC_RINGBUFFERSTORAGE_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Page-aligned memory for a ring buffer, optionally backed by huge pages,
+ * bound to a NUMA node, pre-faulted and locked.
+ *
+ * Large ring buffers on 4 KiB pages spend time in TLB misses, and memory that
+ * is first touched by the wrong thread may end up on the wrong NUMA node.
+ * This class maps the memory up front so that neither happens on the hot
+ * path:
+ *
+ * @code
+ * RingBufferStorage storage(64 << 20,
+ *                           RingBufferStorage::HUGE_PAGES |
+ *                               RingBufferStorage::PREFAULT,
+ *                           node);
+ * RingBuffer ring_buffer(storage.getBuffer(), storage.getSize());
+ * @endcode
+ *
+ * On Linux, huge pages come from @c mmap() with @c MAP_HUGETLB, falling back
+ * to transparent huge pages with @c madvise() if the huge page pool (on the
+ * requested node, if any) is empty, and the node binding uses @c mbind(). On
+ * Windows, huge pages are large pages, which need the "Lock pages in memory"
+ * privilege, and the node binding uses @c VirtualAllocExNuma(). Other systems
+ * ignore both.
+ *
+ * @warning
+ * The memory must outlive any ring buffer that uses it.
+ */
+class RingBufferStorage {
+public:
+    /**
+     * Options for the memory, which may be combined with @c |.
+     */
+    enum Flags : unsigned {
+        /** Uses the system's base pages. */
+        NONE = 0,
+        /** Uses 2 MiB huge pages if it can. */
+        HUGE_PAGES = 1u << 0,
+        /** Uses 1 GiB huge pages if it can, then 2 MiB ones. */
+        GIGANTIC_PAGES = 1u << 1,
+        /** Touches every page before the constructor returns. */
+        PREFAULT = 1u << 2,
+        /** Locks the memory into RAM if it can. */
+        LOCK = 1u << 3
+    };
+
+    /**
+     * The node to pass for memory that is not bound to a NUMA node.
+     */
+    static const int ANY_NODE = -1;
+
+    /**
+     * Maps the memory.
+     *
+     * @param[in] minimumSize
+     * The minimum size of the memory in bytes. The actual size is rounded up
+     * to a multiple of the page size that the flags ask for, whether or not
+     * the system can supply pages of that size.
+     *
+     * @param[in] flags
+     * A combination of Flags.
+     *
+     * @param[in] node
+     * The NUMA node to take the pages from, or ANY_NODE.
+     *
+     * @note
+     * Check isValid() to find out whether the mapping succeeded. Binding to a
+     * node that does not exist fails. Huge pages and locking are best effort:
+     * check getPageSize() and isLocked() to find out what the system granted.
+     */
+    explicit RingBufferStorage(std::size_t minimumSize, unsigned flags = NONE,
+                               int node = ANY_NODE);
+
+    /**
+     * Unmaps the memory.
+     */
+    ~RingBufferStorage();
+
+    RingBufferStorage(const RingBufferStorage &) = delete;
+    RingBufferStorage &operator=(const RingBufferStorage &) = delete;
+
+    /**
+     * Takes over the mapping of another object, leaving the other object
+     * invalid.
+     */
+    RingBufferStorage(RingBufferStorage &&other) noexcept;
+
+    /**
+     * Unmaps the memory, then takes over the mapping of another object,
+     * leaving the other object invalid.
+     */
+    RingBufferStorage &operator=(RingBufferStorage &&other) noexcept;
+
+    /**
+     * Returns whether the memory was mapped successfully.
+     */
+    bool isValid() const { return _buffer != nullptr; }
+
+    /**
+     * Returns the first byte of the memory, or @c nullptr if the mapping
+     * failed.
+     */
+    void *getBuffer() const { return _buffer; }
+
+    /**
+     * Returns the size of the memory in bytes, or 0 if the mapping failed.
+     */
+    std::size_t getSize() const { return _size; }
+
+    /**
+     * Returns the size of the pages that are known to back the memory, or 0
+     * if the mapping failed.
+     *
+     * Transparent huge pages are only a hint to the kernel, so memory that
+     * falls back to them reports the base page size.
+     */
+    std::size_t getPageSize() const { return _pageSize; }
+
+    /**
+     * Returns whether the memory is locked into RAM.
+     */
+    bool isLocked() const { return _locked; }
+
+    /**
+     * Returns the size of the system's base pages.
+     */
+    static std::size_t getBasePageSize();
+
+private:
+    char *_buffer;         //!< The memory.
+    std::size_t _size;     //!< The size of the memory.
+    std::size_t _pageSize; //!< The size of the pages backing the memory.
+    bool _locked;          //!< Whether the memory is locked.
+
+    void _unmap();
+}; // class RingBufferStorage
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFERSTORAGE_H
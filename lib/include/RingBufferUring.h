@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class RingBufferUring.
+ *
+ * @note
+ * Only available on Linux, and only built with the CMake option
+ * @c RINGBUFFER_IO_URING, which defines @c HDC_RINGBUFFER_IO_URING.
+ */
+
+#ifndef _HDC_RINGBUFFERURING_H
+#define _HDC_RINGBUFFERURING_H
+
+#include "RingBuffer.h"
+
+#include <cstddef>
+
+#include <sys/types.h>
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Moves data between a RingBuffer and file descriptors with io_uring, using
+ * the ring buffer's memory as a registered buffer.
+ *
+ * The constructor registers the ring buffer's memory with the kernel once, so
+ * reads and writes run as @c IORING_OP_READ_FIXED and @c IORING_OP_WRITE_FIXED
+ * without pinning pages for each operation. prepareRead() and prepareWrite()
+ * queue an operation on the free or readable spans, as two linked entries if
+ * the region wraps, and submit() hands every queued operation to the kernel
+ * with a single system call and applies the completions with
+ * RingBuffer::commitWrite() and RingBuffer::consume().
+ *
+ * At most one read and one write are in flight at a time, so data arrives and
+ * leaves in order.
+ *
+ * Talks to the kernel with raw system calls, without liburing.
+ *
+ * @warning
+ * The client code must not write to the ring buffer while a read is pending,
+ * nor read from it while a write is pending. Reading while a read is pending
+ * is fine.
+ *
+ * @warning
+ * The object must not be destroyed while an operation is pending, since the
+ * kernel may still be transferring data.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+class RingBufferUring {
+public:
+    /**
+     * Sets up an io_uring instance and registers the ring buffer's memory.
+     *
+     * @param[in,out] ringBuffer
+     * The ring buffer to transfer data for.
+     *
+     * @param[in] buffer
+     * The buffer that the ring buffer adapts.
+     *
+     * @param[in] size
+     * The size of the buffer in bytes, or twice that for a mirrored ring
+     * buffer.
+     *
+     * @note
+     * Check isValid() to find out whether setup succeeded. It fails on kernels
+     * without io_uring, or where io_uring is disabled.
+     */
+    RingBufferUring(RingBuffer &ringBuffer, void *buffer, std::size_t size);
+
+    /**
+     * Tears down the io_uring instance.
+     */
+    ~RingBufferUring();
+
+    RingBufferUring(const RingBufferUring &) = delete;
+    RingBufferUring &operator=(const RingBufferUring &) = delete;
+
+    /**
+     * Returns whether setup succeeded.
+     */
+    bool isValid() const { return _fd != -1; }
+
+    /**
+     * Returns whether a read was queued and has not completed yet.
+     */
+    bool isReadPending() const { return _read.parts != 0; }
+
+    /**
+     * Returns whether a write was queued and has not completed yet.
+     */
+    bool isWritePending() const { return _write.parts != 0; }
+
+    /**
+     * Queues a read from a file descriptor into the ring buffer.
+     *
+     * @param[in] fd
+     * The file descriptor to read from.
+     *
+     * @param[in] max
+     * The maximum number of bytes to read.
+     *
+     * @return
+     * Whether the read was queued, which is @c false if a read is already
+     * pending or if the ring buffer is full.
+     */
+    bool prepareRead(int fd, std::size_t max);
+
+    /**
+     * Queues a write from the ring buffer to a file descriptor.
+     *
+     * @param[in] fd
+     * The file descriptor to write to.
+     *
+     * @param[in] max
+     * The maximum number of bytes to write.
+     *
+     * @return
+     * Whether the write was queued, which is @c false if a write is already
+     * pending or if the ring buffer is empty.
+     */
+    bool prepareWrite(int fd, std::size_t max);
+
+    /**
+     * Submits the queued operations and applies any completions to the ring
+     * buffer.
+     *
+     * @param[in] wait
+     * Whether to block until at least one pending operation completes.
+     *
+     * @return
+     * The number of operations that completed, or -1 with @c errno set if the
+     * system call failed.
+     */
+    int submit(bool wait = false);
+
+    /**
+     * Returns the result of the last completed read: the number of bytes
+     * read, 0 at end of file, or a negated @c errno value.
+     */
+    ssize_t getReadResult() const { return _read.result; }
+
+    /**
+     * Returns the result of the last completed write: the number of bytes
+     * written, or a negated @c errno value.
+     */
+    ssize_t getWriteResult() const { return _write.result; }
+
+private:
+    /**
+     * An operation of up to one entry per span.
+     */
+    struct _Operation {
+        unsigned parts;      //!< The entries still to complete, or 0.
+        char *start;         //!< Where the first span started.
+        std::size_t length;  //!< The length of the first span.
+        ssize_t transferred; //!< The bytes transferred so far.
+        ssize_t result;      //!< The result of the last operation.
+    };
+
+    RingBuffer &_ringBuffer; //!< The ring buffer.
+    char *_buffer;           //!< The registered buffer.
+    std::size_t _size;       //!< The size of the registered buffer.
+    int _fd;                 //!< The io_uring file descriptor.
+
+    void *_rings;            //!< The shared submission and completion rings.
+    std::size_t _ringsSize;  //!< The size of the rings mapping.
+    io_uring_sqe *_sqes;     //!< The submission queue entries.
+    std::size_t _sqesSize;   //!< The size of the entries mapping.
+    unsigned *_sqHead;       //!< The head of the submission ring.
+    unsigned *_sqTail;       //!< The tail of the submission ring.
+    unsigned *_sqArray;      //!< The submission ring's entry indexes.
+    unsigned _sqMask;        //!< The submission ring index mask.
+    unsigned _sqEntries;     //!< The number of submission entries.
+    unsigned *_cqHead;       //!< The head of the completion ring.
+    unsigned *_cqTail;       //!< The tail of the completion ring.
+    io_uring_cqe *_cqes;     //!< The completion queue entries.
+    unsigned _cqMask;        //!< The completion ring index mask.
+    unsigned _unsubmitted;   //!< The entries queued but not submitted.
+
+    _Operation _read;  //!< The pending read, if any.
+    _Operation _write; //!< The pending write, if any.
+
+    bool _prepare(_Operation &operation, unsigned opcode, int fd,
+                  const SpanPair &spans);
+    bool _complete(_Operation &operation, unsigned part, int result);
+    void _teardown();
+}; // class RingBufferUring
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFERURING_H
@@ -0,0 +1,215 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Declares class ShardedRingBuffer.
+ */
+
+#ifndef _HDC_SHARDEDRINGBUFFER_H
+#define _HDC_SHARDEDRINGBUFFER_H
+
+#include "CacheLine.h"
+#include "SpscRingBuffer.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Many-producer, single-consumer message queue made of one SpscRingBuffer
+ * shard per producer.
+ *
+ * Each producer thread writes only to its own shard, so producers never
+ * touch each other's cache lines, and the consumer drains the shards in the
+ * order it chooses. Every shard, and the SpscRingBuffer object that manages
+ * it, is carved from a single client-supplied arena.
+ *
+ * Each message carries a client-supplied sequence number, such as a
+ * timestamp from a clock that all producers share. Draining in
+ * Order::OLDEST merges the shards by it.
+ *
+ * @warning
+ * The client code must not reuse or delete the supplied arena memory for the
+ * lifetime of the ring buffer.
+ *
+ * @warning
+ * At most one thread at a time may write to each shard, and at most one
+ * thread at a time may read.
+ */
+class ShardedRingBuffer {
+public:
+    /**
+     * How the consumer picks the shard to read the next message from.
+     */
+    enum class Order {
+        /** Takes turns among the shards that hold messages. */
+        ROUND_ROBIN,
+        /** Reads from the shard with the most bytes waiting. */
+        FULLEST,
+        /** Reads the message with the smallest sequence number. */
+        OLDEST
+    };
+
+    /**
+     * The number of shard bytes a message takes up on top of its size.
+     */
+    static const std::size_t HEADER_SIZE = 16;
+
+    /**
+     * Returns the arena size needed for a given number of shards of a given
+     * size.
+     *
+     * @param[in] shardCount
+     * The number of shards.
+     *
+     * @param[in] shardSize
+     * The minimum size of each shard in bytes.
+     */
+    static std::size_t getArenaSize(std::size_t shardCount,
+                                    std::size_t shardSize) {
+        return shardCount * (sizeof(SpscRingBuffer) +
+                             (shardSize + CACHE_LINE_SIZE - 1) /
+                                 CACHE_LINE_SIZE * CACHE_LINE_SIZE);
+    }
+
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] arena
+     * The memory to carve the shards from. Must be aligned to
+     * CACHE_LINE_SIZE.
+     *
+     * @param[in] size
+     * The size of the arena in bytes. It is divided evenly between the shards,
+     * each of which starts on a cache line of its own and must hold at least
+     * one cache line.
+     *
+     * @param[in] shardCount
+     * The number of shards, typically one per producer thread. Must not be
+     * zero.
+     */
+    ShardedRingBuffer(void *arena, std::size_t size, std::size_t shardCount);
+
+    /**
+     * Destroys the shards.
+     */
+    ~ShardedRingBuffer();
+
+    ShardedRingBuffer(const ShardedRingBuffer &) = delete;
+    ShardedRingBuffer &operator=(const ShardedRingBuffer &) = delete;
+
+    /**
+     * Returns the number of shards.
+     */
+    std::size_t getShardCount() const { return _shardCount; }
+
+    /**
+     * Returns the size of each shard in bytes.
+     */
+    std::size_t getShardSize() const { return _shardSize; }
+
+    /**
+     * Returns whether every shard is empty.
+     *
+     * @note
+     * The result is only a snapshot: producers may add messages at any time.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Writes a message into a shard.
+     *
+     * @param[in] shard
+     * The index of the shard, which only the calling thread writes to.
+     *
+     * @param[in] message
+     * The message. May be @c nullptr if @p size is 0.
+     *
+     * @param[in] size
+     * The size of the message in bytes.
+     *
+     * @param[in] sequence
+     * The sequence number that Order::OLDEST sorts messages by. Must not
+     * decrease from one message to the next in the same shard.
+     *
+     * @return
+     * Whether the message was written, which is @c false if the shard does not
+     * have room for the message and its header.
+     */
+    bool writeMessage(std::size_t shard, const void *message, std::size_t size,
+                      std::uint64_t sequence = 0);
+
+    /**
+     * Reads a message from one of the shards and removes it.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] capacity
+     * The size of the destination buffer in bytes.
+     *
+     * @param[out] size
+     * The size of the message in bytes, if there is a message.
+     *
+     * @param[in] order
+     * How to pick the shard.
+     *
+     * @return
+     * Whether a message was read, which is @c false if every shard is empty or
+     * if the picked message is larger than @p capacity. In the latter case,
+     * the message stays in its shard.
+     */
+    bool readMessage(void *destination, std::size_t capacity,
+                     std::size_t &size, Order order = Order::ROUND_ROBIN);
+
+private:
+    /**
+     * Precedes each message in its shard.
+     */
+    struct _Header {
+        std::uint64_t sequence; //!< The client-supplied sequence number.
+        std::uint64_t size;     //!< The size of the message in bytes.
+    };
+
+    SpscRingBuffer *_shards;  //!< The shards, at the start of the arena.
+    std::size_t _shardCount;  //!< The number of shards.
+    std::size_t _shardSize;   //!< The size of each shard.
+    std::size_t _next;        //!< The next shard to try in round-robin order.
+
+    /**
+     * Returns the shard to read the next message from in a given order, or
+     * _shardCount if every shard is empty.
+     */
+    std::size_t _pickShard(Order order, _Header &header);
+}; // class ShardedRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_SHARDEDRINGBUFFER_H
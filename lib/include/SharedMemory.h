@@ -0,0 +1,146 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Declares class SharedMemory.
+ */
+
+#ifndef _HDC_SHAREDMEMORY_H
+#define _HDC_SHAREDMEMORY_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Named memory that several processes on the same host can map at once.
+ *
+ * One process creates the memory under a name and the others open it by that
+ * name. Each process maps the memory at its own address, so data in it must
+ * not contain pointers. SharedRingBuffer keeps its whole state in such memory.
+ *
+ * Uses @c shm_open() and @c mmap() on POSIX systems and
+ * @c CreateFileMappingW() and @c MapViewOfFile() on Windows.
+ *
+ * @warning
+ * The memory must outlive any ring buffer that uses it.
+ */
+class SharedMemory {
+public:
+    /**
+     * Creates and maps new memory, filled with zeros.
+     *
+     * @param[in] name
+     * The name of the memory, such as <tt>"/my-ring"</tt>. On POSIX systems,
+     * the name should start with a slash and contain no other slash.
+     *
+     * @param[in] size
+     * The size of the memory in bytes.
+     *
+     * @note
+     * Fails if memory with the same name already exists. Check isValid() to
+     * find out whether the mapping succeeded.
+     */
+    SharedMemory(const char *name, std::size_t size);
+
+    /**
+     * Maps existing memory created by another SharedMemory object, typically
+     * in another process.
+     *
+     * @param[in] name
+     * The name the memory was created with.
+     *
+     * @note
+     * Check isValid() to find out whether the mapping succeeded.
+     */
+    explicit SharedMemory(const char *name);
+
+    /**
+     * Unmaps the memory. The memory itself lives on until it is unmapped
+     * everywhere and, on POSIX systems, its name is removed with remove().
+     */
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory &) = delete;
+    SharedMemory &operator=(const SharedMemory &) = delete;
+
+    /**
+     * Takes over the mapping of another object, leaving the other object
+     * invalid.
+     */
+    SharedMemory(SharedMemory &&other) noexcept;
+
+    /**
+     * Unmaps the memory, then takes over the mapping of another object,
+     * leaving the other object invalid.
+     */
+    SharedMemory &operator=(SharedMemory &&other) noexcept;
+
+    /**
+     * Returns whether the memory was mapped successfully.
+     */
+    bool isValid() const { return _buffer != nullptr; }
+
+    /**
+     * Returns the first byte of the memory, or @c nullptr if the mapping
+     * failed. The memory is aligned to a page.
+     */
+    void *getBuffer() const { return _buffer; }
+
+    /**
+     * Returns the size of the memory in bytes, or 0 if the mapping failed.
+     *
+     * @note
+     * When opening existing memory, the size may have been rounded up to a
+     * multiple of the page size.
+     */
+    std::size_t getSize() const { return _size; }
+
+    /**
+     * Removes a name, so that no other process can open the memory by it.
+     * Processes that have already mapped the memory keep it.
+     *
+     * @return
+     * Whether the name was removed. Always @c true on Windows, where the
+     * memory disappears along with its last mapping.
+     */
+    static bool remove(const char *name);
+
+private:
+    void *_buffer;     //!< The mapping.
+    std::size_t _size; //!< The size of the mapping.
+#if defined(_WIN32)
+    void *_handle; //!< The file mapping object, which keeps the name alive.
+#endif
+
+    void _unmap();
+}; // class SharedMemory
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_SHAREDMEMORY_H
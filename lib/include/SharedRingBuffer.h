@@ -0,0 +1,306 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Declares class SharedRingBuffer.
+ */
+
+#ifndef _HDC_SHAREDRINGBUFFER_H
+#define _HDC_SHAREDRINGBUFFER_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Single-producer, single-consumer ring buffer whose entire state lives in the
+ * memory it adapts, so that it can be shared between processes.
+ *
+ * The memory starts with a control block holding a magic number, a layout
+ * version, the capacity and the read and write indexes, followed by the data.
+ * One process formats the memory with initialize(); any process that maps the
+ * same memory, such as SharedMemory, can then attach a SharedRingBuffer to it.
+ * Each side uses its own SharedRingBuffer object, which holds only pointers
+ * into the memory and a cached copy of the other side's index.
+ *
+ * The producer may call writeBytes(). The consumer may call readBytes(),
+ * discardBytes() and peekBytes(). Either may call the query functions, but
+ * the result is only a snapshot: the other side may change the state at any
+ * time.
+ *
+ * @note
+ * Uses the same protocol as SpscRingBuffer, with lock-free 64-bit atomics in
+ * the control block. As with any shared memory protocol, the processes must
+ * trust each other: a process that corrupts the indexes corrupts the data.
+ *
+ * @warning
+ * The memory must outlive the ring buffer.
+ *
+ * @warning
+ * At most one thread in one process may act as the producer and at most one
+ * as the consumer at any given time.
+ */
+class SharedRingBuffer {
+public:
+    /**
+     * Returns the size of the memory needed for a given capacity.
+     *
+     * @param[in] capacity
+     * The capacity in bytes.
+     */
+    static constexpr std::size_t getMemorySize(std::size_t capacity) {
+        return sizeof(_Control) + capacity;
+    }
+
+    /**
+     * Formats memory as an empty ring buffer that uses all of the memory after
+     * the control block.
+     *
+     * @param[out] memory
+     * The memory. Must be aligned to 128 bytes, as a page is.
+     *
+     * @param[in] size
+     * The size of the memory in bytes. Must exceed getMemorySize(0).
+     *
+     * @warning
+     * No process may be using the memory as a ring buffer at the time.
+     */
+    static void initialize(void *memory, std::size_t size);
+
+    /**
+     * Attaches to memory formatted by initialize(), typically in another
+     * process.
+     *
+     * @param[in] memory
+     * The memory.
+     *
+     * @param[in] size
+     * The size of the memory in bytes.
+     *
+     * @note
+     * Check isValid() to find out whether the memory holds a ring buffer of a
+     * compatible version that fits in @p size bytes.
+     */
+    SharedRingBuffer(void *memory, std::size_t size);
+
+    SharedRingBuffer(const SharedRingBuffer &) = delete;
+    SharedRingBuffer &operator=(const SharedRingBuffer &) = delete;
+
+    /**
+     * Returns whether the ring buffer attached successfully. No other
+     * function may be called if not.
+     */
+    bool isValid() const { return _control != nullptr; }
+
+    /**
+     * Returns the capacity in bytes.
+     */
+    std::size_t getCapacity() const { return _size; }
+
+    /**
+     * Returns whether the ring buffer is empty.
+     */
+    bool isEmpty() const { return getReadableByteCount() == 0; }
+
+    /**
+     * Returns whether the ring buffer is full.
+     */
+    bool isFull() const { return getWritableByteCount() == 0; }
+
+    /**
+     * Returns the number of bytes that can be read from the ring buffer.
+     */
+    std::size_t getReadableByteCount() const {
+        _assertValid();
+        return _distance(_control->read.load(std::memory_order_acquire),
+                         _control->write.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of bytes that can be written to the ring buffer.
+     */
+    std::size_t getWritableByteCount() const {
+        return _size - getReadableByteCount();
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @return
+     * The number of bytes read.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes read may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t readBytes(void *destination, std::size_t count) {
+        assert(destination != nullptr);
+        return _readBytes(destination, count, true);
+    }
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return The number of bytes written.
+     *
+     * @note
+     * Producer only.
+     *
+     * @note
+     * The number of bytes written may be less than the number requested if the
+     * ring buffer becomes full.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count);
+
+    /**
+     * Discards bytes from the ring buffer.
+     *
+     * @param[in] count
+     * The number of bytes to discard.
+     *
+     * @return
+     * The number of bytes discarded.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes discarded may be less than the number requested if
+     * the ring buffer becomes empty.
+     */
+    std::size_t discardBytes(std::size_t count) {
+        return _readBytes(nullptr, count, true);
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer without
+     * removing the bytes from the ring buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @return
+     * The number of bytes peeked.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes peeked may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t peekBytes(void *destination, std::size_t count) {
+        assert(destination != nullptr);
+        return _readBytes(destination, count, false);
+    }
+
+private:
+    /**
+     * The control block at the start of the memory.
+     *
+     * The layout is fixed, independent of CACHE_LINE_SIZE, so that processes
+     * built with different settings agree on it. Each index has a 128-byte
+     * block to itself, which also covers processors that fetch cache lines in
+     * pairs.
+     */
+    struct _Control {
+        std::atomic<std::uint32_t> magic; //!< MAGIC once initialized.
+        std::uint32_t version;            //!< VERSION.
+        std::uint32_t controlSize;        //!< sizeof(_Control).
+        std::uint32_t reserved;           //!< Zero.
+        std::uint64_t capacity;           //!< The capacity in bytes.
+
+        /** Counts bytes written, modulo 2 * capacity. */
+        alignas(128) std::atomic<std::uint64_t> write;
+
+        /** Counts bytes read, modulo 2 * capacity. */
+        alignas(128) std::atomic<std::uint64_t> read;
+    };
+
+    /** Identifies memory formatted by initialize(). */
+    static const std::uint32_t MAGIC = 0x48444352; // "HDCR"
+
+    /** The layout version. Changes whenever the layout does. */
+    static const std::uint32_t VERSION = 1;
+
+    _Control *_control;        //!< The control block in shared memory.
+    char *_buffer;             //!< The data, right after the control block.
+    std::size_t _size;         //!< The capacity.
+    std::uint64_t _cachedRead;  //!< The producer's last known read index.
+    std::uint64_t _cachedWrite; //!< The consumer's last known write index.
+
+    /**
+     * Returns the number of bytes from index @p from to index @p to.
+     */
+    std::size_t _distance(std::uint64_t from, std::uint64_t to) const {
+        return static_cast<std::size_t>(to >= from ? to - from
+                                                   : to + 2 * _size - from);
+    }
+
+    /**
+     * Returns the index @p count bytes past index @p index.
+     */
+    std::uint64_t _advance(std::uint64_t index, std::size_t count) const {
+        return index + count < 2 * _size ? index + count
+                                         : index + count - 2 * _size;
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer, or skips
+     * copying if no destination buffer is provided, and optionally removes
+     * them from the ring buffer.
+     */
+    std::size_t _readBytes(void *destination, std::size_t count, bool consume);
+
+    void _assertValid() const;
+}; // class SharedRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_SHAREDRINGBUFFER_H
@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares the span types that expose ring buffer memory without copying.
+ */
+
+#ifndef _HDC_SPAN_H
+#define _HDC_SPAN_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * A contiguous range of writable bytes.
+ */
+struct Span {
+    char *data;       //!< The first byte of the range.
+    std::size_t size; //!< The number of bytes in the range.
+};
+
+/**
+ * A contiguous range of read-only bytes.
+ */
+struct ConstSpan {
+    const char *data; //!< The first byte of the range.
+    std::size_t size; //!< The number of bytes in the range.
+};
+
+/**
+ * Up to two contiguous ranges of bytes that together form one logical range.
+ *
+ * A ring buffer region that wraps around the end of the buffer is split into
+ * @c first, which runs up to the end of the buffer, and @c second, which
+ * starts at the beginning of the buffer. If the region does not wrap, @c second
+ * is empty.
+ */
+struct SpanPair {
+    Span first;  //!< The range before the wrap.
+    Span second; //!< The range after the wrap.
+
+    /**
+     * Returns the total number of bytes in both ranges.
+     */
+    std::size_t size() const { return first.size + second.size; }
+};
+
+/**
+ * Up to two contiguous ranges of read-only bytes that together form one logical
+ * range.
+ *
+ * @see SpanPair
+ */
+struct ConstSpanPair {
+    ConstSpan first;  //!< The range before the wrap.
+    ConstSpan second; //!< The range after the wrap.
+
+    /**
+     * Returns the total number of bytes in both ranges.
+     */
+    std::size_t size() const { return first.size + second.size; }
+};
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_SPAN_H
@@ -0,0 +1,630 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares class SpscRingBuffer.
+ */
+
+#ifndef _HDC_SPSCRINGBUFFER_H
+#define _HDC_SPSCRINGBUFFER_H
+
+#include "CacheLine.h"
+#include "CopyFunction.h"
+#include "RingBufferStats.h"
+#include "Span.h"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+// Structure was padded due to alignment specifier.
+#pragma warning(disable : 4324)
+#endif
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Single-producer, single-consumer ring buffer adapter.
+ *
+ * Adapts a client-supplied buffer into a ring buffer that one producer thread
+ * and one consumer thread can use concurrently without locking.
+ *
+ * The producer thread may call writeBytes(), writeBytesWait() and
+ * writeBatch(). The consumer thread may call readBytes(), readBytesWait(),
+ * readBatch(), discardBytes(), peekBytes(), peekBytesAt() and clear(). Either
+ * thread may call the query functions, but the result is only a snapshot: the
+ * other thread may change the state at any time.
+ *
+ * @note
+ * Uses <tt>std::memcpy()</tt> to copy data, unless setCopyFunction() says
+ * otherwise.
+ *
+ * @note
+ * The producer-owned and consumer-owned state live on separate cache lines.
+ * If you allocate the ring buffer object dynamically, use an allocator that
+ * honours over-aligned types (C++17 or later) to keep them apart.
+ *
+ * @warning
+ * The client code must not reuse or delete the supplied buffer memory for the
+ * lifetime of the ring buffer.
+ *
+ * @warning
+ * At most one thread may act as the producer and at most one thread may act as
+ * the consumer at any given time.
+ */
+class SpscRingBuffer {
+public:
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] buffer
+     * The buffer to adapt into a ring buffer.
+     *
+     * @param[in] size
+     * The size of the buffer in bytes.
+     */
+    SpscRingBuffer(void *buffer, std::size_t size)
+        : _buffer(static_cast<char *>(buffer)), _size(size),
+          _asymmetricFences(_haveAsymmetricFences()), _copyFunction(nullptr),
+          _copyThreshold(0), _write(0), _cachedRead(0),
+          _writeSpin(INITIAL_SPIN),
+#if defined(HDC_RINGBUFFER_STATS)
+          _bytesWritten(0), _shortWrites(0), _fullCount(0), _wrapCount(0),
+          _peakReadableBytes(0),
+#endif
+          _read(0), _cachedWrite(0), _readSpin(INITIAL_SPIN),
+#if defined(HDC_RINGBUFFER_STATS)
+          _bytesRead(0), _shortReads(0), _emptyCount(0),
+#endif
+          _readWaiting(0), _writeWaiting(0) {
+        _assertValid();
+    }
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+    /**
+     * Returns whether the ring buffer is empty.
+     */
+    bool isEmpty() const { return getReadableByteCount() == 0; }
+
+    /**
+     * Returns whether the ring buffer is full.
+     */
+    bool isFull() const { return getWritableByteCount() == 0; }
+
+    /**
+     * Returns the number of bytes that can be read from the ring buffer.
+     */
+    std::size_t getReadableByteCount() const {
+        _assertValid();
+        return _distance(_read.load(std::memory_order_acquire),
+                         _write.load(std::memory_order_acquire));
+    }
+
+    /**
+     * Returns the number of bytes that can be written to the ring buffer.
+     */
+    std::size_t getWritableByteCount() const {
+        return _size - getReadableByteCount();
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @return
+     * The number of bytes read.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes read may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t readBytes(void *destination, std::size_t count) {
+        assert(destination != nullptr);
+        return _readBytes(destination, count, 0, true);
+    }
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @return The number of bytes written.
+     *
+     * @note
+     * Producer only.
+     *
+     * @note
+     * The number of bytes written may be less than the number requested if the
+     * ring buffer becomes full.
+     */
+    std::size_t writeBytes(const void *source, std::size_t count);
+
+    /**
+     * Writes messages from a gather list into the ring buffer.
+     *
+     * Writes each message in turn, stopping at the first one that does not
+     * fit in its entirety, and publishes the whole batch to the consumer at
+     * once.
+     *
+     * @param[in] messages
+     * The messages to write.
+     *
+     * @param[in] count
+     * The number of messages.
+     *
+     * @return
+     * The number of messages written.
+     *
+     * @note
+     * Producer only.
+     *
+     * @note
+     * The number of messages written may be less than the number requested if
+     * the ring buffer becomes full. A message is never written in part.
+     */
+    std::size_t writeBatch(const ConstSpan *messages, std::size_t count);
+
+    /**
+     * Reads messages from the ring buffer into a scatter list.
+     *
+     * Fills each destination in turn, stopping at the first one that the
+     * readable bytes cannot fill in its entirety, and releases the whole batch
+     * to the producer at once.
+     *
+     * @param[out] messages
+     * The destinations to fill.
+     *
+     * @param[in] count
+     * The number of destinations.
+     *
+     * @return
+     * The number of destinations filled.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of destinations filled may be less than the number requested
+     * if the ring buffer becomes empty. A destination is never filled in part.
+     */
+    std::size_t readBatch(const Span *messages, std::size_t count);
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer, waiting for
+     * them to become readable first.
+     *
+     * Spins briefly, then sleeps until the producer has written enough bytes
+     * or the timeout expires.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to read.
+     *
+     * @param[in] timeout
+     * The longest time to wait. <tt>std::chrono::nanoseconds::max()</tt>
+     * waits forever.
+     *
+     * @return
+     * The number of bytes read.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * Waits for @p count bytes, or for a full ring buffer if @p count exceeds
+     * its size. If the timeout expires first, reads whatever is readable,
+     * which may be nothing.
+     */
+    std::size_t readBytesWait(void *destination, std::size_t count,
+                              std::chrono::nanoseconds timeout);
+
+    /**
+     * Writes bytes from a source buffer into the ring buffer, waiting for
+     * space to become free first.
+     *
+     * Spins briefly, then sleeps until the consumer has freed enough space or
+     * the timeout expires.
+     *
+     * @param[in] source
+     * The source buffer.
+     *
+     * @param[in] count
+     * The number of bytes to write.
+     *
+     * @param[in] timeout
+     * The longest time to wait. <tt>std::chrono::nanoseconds::max()</tt>
+     * waits forever.
+     *
+     * @return
+     * The number of bytes written.
+     *
+     * @note
+     * Producer only.
+     *
+     * @note
+     * Waits for @p count bytes of space, or for an empty ring buffer if
+     * @p count exceeds its size. If the timeout expires first, writes whatever
+     * fits, which may be nothing.
+     */
+    std::size_t writeBytesWait(const void *source, std::size_t count,
+                               std::chrono::nanoseconds timeout);
+
+    /**
+     * Discards bytes from the ring buffer.
+     *
+     * @param[in] count
+     * The number of bytes to discard.
+     *
+     * @return
+     * The number of bytes discarded.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes discarded may be less than the number requested if
+     * the ring buffer becomes empty.
+     */
+    std::size_t discardBytes(std::size_t count) {
+        return _readBytes(nullptr, count, 0, true);
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer without
+     * removing the bytes from the ring buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @return
+     * The number of bytes peeked.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes peeked may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t peekBytes(void *destination, std::size_t count) {
+        assert(destination != nullptr);
+        return _readBytes(destination, count, 0, false);
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer starting at a
+     * given offset in the ring buffer without removing the bytes from the ring
+     * buffer.
+     *
+     * @param[out] destination
+     * The destination buffer.
+     *
+     * @param[in] count
+     * The number of bytes to peek.
+     *
+     * @param[in] where
+     * The offset relative to the first byte in the ring buffer.
+     *
+     * @return
+     * The number of bytes peeked.
+     *
+     * @note
+     * Consumer only.
+     *
+     * @note
+     * The number of bytes peeked may be less than the number requested if the
+     * ring buffer becomes empty.
+     */
+    std::size_t peekBytesAt(void *destination, std::size_t count,
+                            std::size_t where) {
+        assert(destination != nullptr);
+        return _readBytes(destination, count, where, false);
+    }
+
+    /**
+     * Sets the function that copies data into and out of the ring buffer.
+     *
+     * @param[in] copy
+     * The copy function, such as nonTemporalCopy(), or @c nullptr for
+     * <tt>std::memcpy()</tt>. It must have completed its stores when it
+     * returns, since the ring buffer then publishes them to the other thread.
+     *
+     * @param[in] threshold
+     * The smallest copy, in bytes, to use @p copy for. Smaller copies use
+     * <tt>std::memcpy()</tt>.
+     *
+     * @note
+     * Applies to writeBytes(), readBytes() and the other byte functions, but
+     * not to writeBatch() and readBatch(). Only call it while neither thread
+     * is using the ring buffer.
+     */
+    void setCopyFunction(CopyFunction copy, std::size_t threshold = 0) {
+        _copyFunction = copy;
+        _copyThreshold = threshold;
+    }
+
+    /**
+     * Returns the function set by setCopyFunction(), or @c nullptr if the ring
+     * buffer uses <tt>std::memcpy()</tt>.
+     */
+    CopyFunction getCopyFunction() const { return _copyFunction; }
+
+    /**
+     * Returns a snapshot of the usage statistics.
+     *
+     * @note
+     * All zero unless built with @c HDC_RINGBUFFER_STATS. See RingBufferStats.
+     *
+     * @note
+     * Either thread may call it. Each counter is exact, but the counters are
+     * read one by one while the other thread may be updating them. The peak
+     * may overstate the true peak slightly, since the producer computes it
+     * with its cached copy of the consumer's index.
+     */
+    RingBufferStats getStats() const;
+
+    /**
+     * Empties out the ring buffer.
+     *
+     * @note
+     * Consumer only. Bytes that the producer writes concurrently may or may not
+     * be discarded.
+     */
+    void clear() {
+        _cachedWrite = _write.load(std::memory_order_acquire);
+        _read.store(_cachedWrite, std::memory_order_release);
+        _signal(_writeWaiting);
+    }
+
+private:
+    /** How many times a waiting thread first polls the ring buffer. */
+    static const unsigned INITIAL_SPIN = 256;
+
+    char *_buffer;          //!< The client-supplied buffer.
+    std::size_t _size;      //!< The size of the buffer.
+    bool _asymmetricFences; //!< Whether a sleeper can fence for the waker.
+    CopyFunction _copyFunction; //!< Copies data, or nullptr for memcpy.
+    std::size_t _copyThreshold; //!< The smallest copy for _copyFunction.
+
+    /** Counts bytes written, modulo 2 * _size. Written by the producer only. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _write;
+    std::size_t _cachedRead; //!< The producer's last known value of _read.
+    unsigned _writeSpin;     //!< How long writeBytesWait() spins.
+#if defined(HDC_RINGBUFFER_STATS)
+    /** The producer's statistics, each written by the producer only. */
+    std::atomic<std::uint64_t> _bytesWritten, _shortWrites, _fullCount,
+        _wrapCount, _peakReadableBytes;
+#endif
+
+    /** Counts bytes read, modulo 2 * _size. Written by the consumer only. */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> _read;
+    std::size_t _cachedWrite; //!< The consumer's last known value of _write.
+    unsigned _readSpin;       //!< How long readBytesWait() spins.
+#if defined(HDC_RINGBUFFER_STATS)
+    /** The consumer's statistics, each written by the consumer only. */
+    std::atomic<std::uint64_t> _bytesRead, _shortReads, _emptyCount;
+#endif
+
+    /** Non-zero while the consumer sleeps in readBytesWait(). */
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> _readWaiting;
+    /** Non-zero while the producer sleeps in writeBytesWait(). */
+    std::atomic<std::uint32_t> _writeWaiting;
+
+#if defined(HDC_RINGBUFFER_STATS)
+    /**
+     * Adds to a counter that only the calling thread writes, which needs no
+     * read-modify-write operation.
+     */
+    static void _add(std::atomic<std::uint64_t> &counter,
+                     std::uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+#endif
+
+    /**
+     * Updates the producer's statistics after a write that started at index
+     * @p write, wrote @p written bytes, was short if @p isShort and left
+     * @p writable bytes free.
+     */
+    void _countWrite(std::size_t write, std::size_t written, bool isShort,
+                     std::size_t writable) {
+#if defined(HDC_RINGBUFFER_STATS)
+        _add(_bytesWritten, written);
+        if (isShort) {
+            _add(_shortWrites, 1);
+        }
+        if (written != 0) {
+            if (writable == 0) {
+                _add(_fullCount, 1);
+            }
+            auto offset = write < _size ? write : write - _size;
+            if (offset + written >= _size) {
+                _add(_wrapCount, 1);
+            }
+            if (_size - writable >
+                _peakReadableBytes.load(std::memory_order_relaxed)) {
+                _peakReadableBytes.store(_size - writable,
+                                         std::memory_order_relaxed);
+            }
+        }
+#else
+        (void)write;
+        (void)written;
+        (void)isShort;
+        (void)writable;
+#endif
+    }
+
+    /**
+     * Updates the consumer's statistics after a read or discard of @p read
+     * bytes that was short if @p isShort and left @p readable bytes.
+     */
+    void _countRead(std::size_t read, bool isShort, std::size_t readable) {
+#if defined(HDC_RINGBUFFER_STATS)
+        _add(_bytesRead, read);
+        if (isShort) {
+            _add(_shortReads, 1);
+        }
+        if (read != 0 && readable == 0) {
+            _add(_emptyCount, 1);
+        }
+#else
+        (void)read;
+        (void)isShort;
+        (void)readable;
+#endif
+    }
+
+    /**
+     * Copies bytes with the copy function if one is set and the copy is large
+     * enough, and with <tt>std::memcpy()</tt> otherwise.
+     */
+    void _copy(void *destination, const void *source,
+               std::size_t count) const {
+        if (_copyFunction != nullptr && count >= _copyThreshold) {
+            _copyFunction(destination, source, count);
+        } else {
+            std::memcpy(destination, source, count);
+        }
+    }
+
+    /**
+     * Returns the number of bytes from index @p from to index @p to.
+     */
+    std::size_t _distance(std::size_t from, std::size_t to) const {
+        return to >= from ? to - from : to + 2 * _size - from;
+    }
+
+    /**
+     * Returns the index @p count bytes past index @p index.
+     */
+    std::size_t _advance(std::size_t index, std::size_t count) const {
+        return index + count < 2 * _size ? index + count
+                                         : index + count - 2 * _size;
+    }
+
+    /**
+     * Reads bytes from the ring buffer into a destination buffer or discards
+     * bytes from the ring buffer if no destination buffer is provided.
+     *
+     * @param[out] destination
+     * The destination buffer to read into or @c nullptr to skip copying.
+     *
+     * @param[in] count
+     * The number of bytes to read or discard.
+     *
+     * @param[in] where
+     * The offset relative to the first byte in the ring buffer.
+     *
+     * @param[in] consume
+     * Whether to remove the bytes from the ring buffer.
+     *
+     * @return
+     * The number of bytes read or discarded.
+     */
+    std::size_t _readBytes(void *destination, std::size_t count,
+                           std::size_t where, bool consume);
+
+    /**
+     * Waits until the ring buffer has a given number of readable or writable
+     * bytes.
+     *
+     * @param[in] count
+     * The number of bytes to wait for. Must not exceed the size of the
+     * buffer.
+     *
+     * @param[in] readable
+     * Whether to wait for readable bytes (consumer) rather than writable bytes
+     * (producer).
+     *
+     * @param[in] timeout
+     * The longest time to wait.
+     */
+    void _wait(std::size_t count, bool readable,
+               std::chrono::nanoseconds timeout);
+
+    /**
+     * Wakes the other side if it sleeps on @p waiting. Called after each
+     * update of this side's index.
+     */
+    void _signal(std::atomic<std::uint32_t> &waiting) const {
+        // Pairs with the fence in _wait(): either the sleeper sees the new
+        // index before it goes to sleep or this side sees its flag. If the
+        // sleeper's fence covers this thread too, only the compiler needs
+        // fencing here.
+        if (_asymmetricFences) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        if (waiting.load(std::memory_order_relaxed) != 0) {
+            _wake(waiting);
+        }
+    }
+
+    static void _wake(std::atomic<std::uint32_t> &waiting);
+
+    /**
+     * Returns whether the platform lets one thread issue a memory barrier on
+     * behalf of all others.
+     */
+    static bool _haveAsymmetricFences();
+    void _assertValid() const;
+}; // class SpscRingBuffer
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // _HDC_SPSCRINGBUFFER_H
@@ -0,0 +1,225 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares and implements class template TypedRingBuffer.
+ */
+
+#ifndef _HDC_TYPEDRINGBUFFER_H
+#define _HDC_TYPEDRINGBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace hdc {
+namespace ringbuffer {
+
+/**
+ * Typed ring buffer adapter with a compile-time capacity.
+ *
+ * A ring buffer of whole items of one type. Since the item size and the
+ * capacity are compile-time constants and the ring buffer only ever holds
+ * whole items, writing or reading one item is a single fixed-size copy with no
+ * partial-item handling, which the compiler can turn into plain loads and
+ * stores.
+ *
+ * The bookkeeping is kept in items rather than delegated to RingBuffer, so
+ * that it can be inlined and the capacity folded into it. Unlike RingBuffer,
+ * this is a template, so each combination of @p T and @p N gets its own
+ * (small, inline) code.
+ *
+ * @tparam T
+ * The item type. Must be trivially copyable.
+ *
+ * @tparam N
+ * The capacity in items.
+ *
+ * @warning
+ * The client code must not reuse or delete the supplied buffer memory for the
+ * lifetime of the ring buffer.
+ *
+ * @warning
+ * The client code is responsible for synchronization.
+ */
+template <class T, std::size_t N> class TypedRingBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "TypedRingBuffer items must be trivially copyable");
+    static_assert(N > 0, "TypedRingBuffer capacity must not be zero");
+
+public:
+    /**
+     * The capacity in items.
+     */
+    static constexpr std::size_t CAPACITY = N;
+
+    /**
+     * Ring buffer constructor.
+     *
+     * @param[in] buffer
+     * The buffer to adapt into a ring buffer.
+     */
+    explicit TypedRingBuffer(T (&buffer)[N])
+        : _buffer(buffer), _read(0), _count(0) {}
+
+    /**
+     * Returns whether the ring buffer is empty.
+     */
+    bool isEmpty() const { return _count == 0; }
+
+    /**
+     * Returns whether the ring buffer is full.
+     */
+    bool isFull() const { return _count == N; }
+
+    /**
+     * Returns the number of items that can be read from the ring buffer.
+     */
+    std::size_t getReadableCount() const { return _count; }
+
+    /**
+     * Returns the number of items that can be written to the ring buffer.
+     */
+    std::size_t getWritableCount() const { return N - _count; }
+
+    /**
+     * Writes one item into the ring buffer.
+     *
+     * @return
+     * Whether the item was written, which is @c false if the ring buffer is
+     * full.
+     */
+    bool write(const T &item) {
+        if (_count == N) {
+            return false;
+        }
+        std::memcpy(_buffer + _wrap(_read + _count), &item, sizeof(T));
+        ++_count;
+        return true;
+    }
+
+    /**
+     * Writes items into the ring buffer.
+     *
+     * @return
+     * The number of items written, which may be less than @p count if the
+     * ring buffer becomes full.
+     */
+    std::size_t write(const T *items, std::size_t count) {
+        count = count < N - _count ? count : N - _count;
+        auto where = _wrap(_read + _count);
+        auto first = count < N - where ? count : N - where;
+        std::memcpy(_buffer + where, items, first * sizeof(T));
+        std::memcpy(_buffer, items + first, (count - first) * sizeof(T));
+        _count += count;
+        return count;
+    }
+
+    /**
+     * Reads one item from the ring buffer.
+     *
+     * @return
+     * Whether an item was read, which is @c false if the ring buffer is empty.
+     */
+    bool read(T &item) {
+        if (!peek(item)) {
+            return false;
+        }
+        _read = _wrap(_read + 1);
+        --_count;
+        return true;
+    }
+
+    /**
+     * Reads items from the ring buffer.
+     *
+     * @return
+     * The number of items read, which may be less than @p count if the ring
+     * buffer becomes empty.
+     */
+    std::size_t read(T *items, std::size_t count) {
+        count = count < _count ? count : _count;
+        auto first = count < N - _read ? count : N - _read;
+        std::memcpy(items, _buffer + _read, first * sizeof(T));
+        std::memcpy(items + first, _buffer, (count - first) * sizeof(T));
+        return discard(count);
+    }
+
+    /**
+     * Reads the first item in the ring buffer without removing it.
+     *
+     * @return
+     * Whether an item was read, which is @c false if the ring buffer is empty.
+     */
+    bool peek(T &item) const {
+        if (_count == 0) {
+            return false;
+        }
+        std::memcpy(&item, _buffer + _read, sizeof(T));
+        return true;
+    }
+
+    /**
+     * Discards items from the ring buffer.
+     *
+     * @return
+     * The number of items discarded, which may be less than @p count if the
+     * ring buffer becomes empty.
+     */
+    std::size_t discard(std::size_t count) {
+        count = count < _count ? count : _count;
+        _read = _wrap(_read + count);
+        _count -= count;
+        return count;
+    }
+
+    /**
+     * Empties out the ring buffer.
+     */
+    void clear() {
+        _read = 0;
+        _count = 0;
+    }
+
+private:
+    T *_buffer;         //!< The buffer.
+    std::size_t _read;  //!< The index of the first item.
+    std::size_t _count; //!< The number of items.
+
+    /**
+     * Wraps an index in [0, 2 * N) into [0, N).
+     */
+    static std::size_t _wrap(std::size_t index) {
+        return index < N ? index : index - N;
+    }
+}; // class TypedRingBuffer
+
+template <class T, std::size_t N>
+constexpr std::size_t TypedRingBuffer<T, N>::CAPACITY;
+
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_TYPEDRINGBUFFER_H
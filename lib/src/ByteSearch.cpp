@@ -0,0 +1,197 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements the byte search kernels used by the ring buffers.
+ */
+
+#include "ByteSearch.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define HDC_RINGBUFFER_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define HDC_RINGBUFFER_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define HDC_RINGBUFFER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * Returns the index of the lowest set bit of a non-zero @p mask.
+ */
+unsigned lowestBit(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+const char *findByteScalar(const char *begin, const char *end,
+                           unsigned char value) {
+    for (; begin != end; ++begin) {
+        if (static_cast<unsigned char>(*begin) == value) {
+            break;
+        }
+    }
+    return begin;
+}
+
+#if defined(HDC_RINGBUFFER_SSE2)
+
+const char *findByteSse2(const char *begin, const char *end,
+                         unsigned char value) {
+    auto needle = _mm_set1_epi8(static_cast<char>(value));
+    for (; end - begin >= 16; begin += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        auto mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return begin + lowestBit(mask);
+        }
+    }
+    return findByteScalar(begin, end, value);
+}
+
+#endif
+
+#if defined(HDC_RINGBUFFER_AVX2)
+
+__attribute__((target("avx2"))) const char *
+findByteAvx2(const char *begin, const char *end, unsigned char value) {
+    auto needle = _mm256_set1_epi8(static_cast<char>(value));
+    // Two vectors per iteration, so that the loop runs at load bandwidth.
+    for (; end - begin >= 64; begin += 64) {
+        auto first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        auto second =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 32));
+        auto firstEqual = _mm256_cmpeq_epi8(first, needle);
+        auto secondEqual = _mm256_cmpeq_epi8(second, needle);
+        if (!_mm256_testz_si256(_mm256_or_si256(firstEqual, secondEqual),
+                                _mm256_or_si256(firstEqual, secondEqual))) {
+            auto mask =
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(firstEqual));
+            if (mask != 0) {
+                return begin + lowestBit(mask);
+            }
+            mask =
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(secondEqual));
+            return begin + 32 + lowestBit(mask);
+        }
+    }
+    for (; end - begin >= 32; begin += 32) {
+        auto chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+        auto mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return begin + lowestBit(mask);
+        }
+    }
+    return findByteSse2(begin, end, value);
+}
+
+#endif
+
+#if defined(HDC_RINGBUFFER_NEON)
+
+/**
+ * Returns the index of the lowest set bit of a non-zero @p mask.
+ */
+unsigned lowestBit64(std::uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+const char *findByteNeon(const char *begin, const char *end,
+                         unsigned char value) {
+    auto needle = vdupq_n_u8(value);
+    for (; end - begin >= 16; begin += 16) {
+        auto chunk = vld1q_u8(reinterpret_cast<const std::uint8_t *>(begin));
+        auto equal = vceqq_u8(chunk, needle);
+        // Narrow each byte of the comparison to four bits of a 64-bit mask.
+        auto mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)),
+            0);
+        if (mask != 0) {
+            return begin + lowestBit64(mask) / 4;
+        }
+    }
+    return findByteScalar(begin, end, value);
+}
+
+#endif
+
+typedef const char *(*FindByteFunction)(const char *, const char *,
+                                        unsigned char);
+
+/**
+ * Picks the best kernel for the processor.
+ */
+FindByteFunction selectFindByte() {
+#if defined(HDC_RINGBUFFER_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return findByteAvx2;
+    }
+#endif
+#if defined(HDC_RINGBUFFER_SSE2)
+    return findByteSse2;
+#elif defined(HDC_RINGBUFFER_NEON)
+    return findByteNeon;
+#else
+    return findByteScalar;
+#endif
+}
+
+} // namespace
+
+const char *hdc::ringbuffer::detail::findByte(const char *begin,
+                                              const char *end,
+                                              unsigned char value) {
+    static const auto function = selectFindByte();
+    return function(begin, end, value);
+}
@@ -0,0 +1,52 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares the byte search kernels used by the ring buffers.
+ */
+
+#ifndef _HDC_BYTESEARCH_H
+#define _HDC_BYTESEARCH_H
+
+#include <cstddef>
+
+namespace hdc {
+namespace ringbuffer {
+namespace detail {
+
+/**
+ * Returns the first byte equal to @p value in <tt>[begin, end)</tt>, or
+ * @p end if there is none.
+ *
+ * Uses the widest vector instructions the processor supports: AVX2 or SSE2 on
+ * x86, NEON on 64-bit ARM and a portable loop elsewhere.
+ */
+const char *findByte(const char *begin, const char *end, unsigned char value);
+
+} // namespace detail
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_BYTESEARCH_H
@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class CompressingRingBuffer.
+ */
+
+#include "CompressingRingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+// Marks the logical size of a block that is stored uncompressed.
+const std::uint32_t RAW = 0x80000000u;
+
+/**
+ * Precedes each block in the ring buffer.
+ */
+struct BlockHeader {
+    std::uint32_t storedSize;  //!< The size of the block in the ring buffer.
+    std::uint32_t logicalSize; //!< The size before compression, and RAW.
+};
+
+static_assert(sizeof(BlockHeader) == CompressingRingBuffer::HEADER_SIZE,
+              "BlockHeader must match HEADER_SIZE");
+
+} // namespace
+
+const std::size_t CompressingRingBuffer::HEADER_SIZE;
+
+CompressingRingBuffer::CompressingRingBuffer(RingBuffer &ring, Codec &codec,
+                                             std::size_t blockSize)
+    : _ring(ring), _codec(codec), _pending(blockSize), _pendingSize(0),
+      _decoded(blockSize), _decodedSize(0), _decodedOffset(0),
+      _scratch(std::max(codec.getMaxCompressedSize(blockSize), blockSize)),
+      _storedLogicalByteCount(0) {
+    assert(blockSize > 0 && blockSize < RAW);
+}
+
+std::size_t CompressingRingBuffer::writeBytes(const void *source,
+                                              std::size_t count) {
+    auto data = static_cast<const char *>(source);
+    auto blockSize = getBlockSize();
+    std::size_t written = 0;
+    while (written < count) {
+        if (_pendingSize == blockSize && !flush()) {
+            break;
+        }
+        // Compress a whole block from the source without gathering it, or
+        // gather it if the ring buffer has no room.
+        if (_pendingSize == 0 && count - written >= blockSize &&
+            _writeBlock(data + written, blockSize)) {
+            written += blockSize;
+            continue;
+        }
+        auto n = std::min(blockSize - _pendingSize, count - written);
+        std::memcpy(_pending.data() + _pendingSize, data + written, n);
+        _pendingSize += n;
+        written += n;
+    }
+    return written;
+}
+
+bool CompressingRingBuffer::flush() {
+    if (_pendingSize == 0) {
+        return true;
+    }
+    if (!_writeBlock(_pending.data(), _pendingSize)) {
+        return false;
+    }
+    _pendingSize = 0;
+    return true;
+}
+
+std::size_t CompressingRingBuffer::readBytes(void *destination,
+                                             std::size_t count) {
+    auto data = static_cast<char *>(destination);
+    std::size_t read = 0;
+    while (read < count) {
+        if (_decodedOffset < _decodedSize) {
+            auto n = std::min(_decodedSize - _decodedOffset, count - read);
+            std::memcpy(data + read, _decoded.data() + _decodedOffset, n);
+            _decodedOffset += n;
+            read += n;
+            if (_decodedOffset == _decodedSize) {
+                _decodedOffset = 0;
+                _decodedSize = 0;
+            }
+            continue;
+        }
+
+        BlockHeader header;
+        if (_ring.peekBytes(&header, sizeof(header)) != sizeof(header)) {
+            break;
+        }
+        auto size = static_cast<std::size_t>(header.logicalSize & ~RAW);
+        auto raw = (header.logicalSize & RAW) != 0;
+        if (count - read >= size) {
+            // Decompress straight into the destination.
+            _readBlock(data + read, size, header.storedSize, raw);
+            read += size;
+        } else {
+            _readBlock(_decoded.data(), size, header.storedSize, raw);
+            _decodedSize = size;
+        }
+    }
+    return read;
+}
+
+void CompressingRingBuffer::clear() {
+    _ring.clear();
+    _pendingSize = 0;
+    _decodedSize = 0;
+    _decodedOffset = 0;
+    _storedLogicalByteCount = 0;
+}
+
+bool CompressingRingBuffer::_writeBlock(const char *block, std::size_t size) {
+    if (_ring.getWritableByteCount() <= HEADER_SIZE) {
+        return false;
+    }
+
+    // Compress straight into the free span if it has room for the worst
+    // case, or into the scratch buffer if it does not.
+    auto bound = _codec.getMaxCompressedSize(size);
+    auto room = HEADER_SIZE + std::max(bound, size);
+    auto spans = _ring.reserveWrite(room);
+    auto direct = spans.first.size == room;
+    auto compressed = direct ? spans.first.data + HEADER_SIZE : _scratch.data();
+    auto storedSize = _codec.compress(compressed, bound, block, size);
+    auto raw = storedSize == 0 || storedSize >= size;
+    if (raw) {
+        storedSize = size;
+    }
+    if (HEADER_SIZE + storedSize > _ring.getWritableByteCount()) {
+        return false;
+    }
+
+    BlockHeader header = {
+        static_cast<std::uint32_t>(storedSize),
+        static_cast<std::uint32_t>(size) | (raw ? RAW : 0)};
+    if (direct) {
+        std::memcpy(spans.first.data, &header, sizeof(header));
+        if (raw) {
+            std::memcpy(spans.first.data + HEADER_SIZE, block, size);
+        }
+        _ring.commitWrite(HEADER_SIZE + storedSize);
+    } else {
+        const ConstSpan parts[] = {
+            {reinterpret_cast<const char *>(&header), sizeof(header)},
+            {raw ? block : compressed, storedSize}};
+        auto written = _ring.writeBatch(parts, 2);
+        assert(written == 2);
+        (void)written;
+    }
+    _storedLogicalByteCount += size;
+    return true;
+}
+
+void CompressingRingBuffer::_readBlock(char *destination, std::size_t size,
+                                       std::size_t storedSize, bool raw) {
+    // Decompress straight from the readable span unless the block wraps.
+    auto spans = _ring.readableSpans();
+    const char *stored = spans.first.data + HEADER_SIZE;
+    if (spans.first.size < HEADER_SIZE + storedSize) {
+        auto peeked = _ring.peekBytesAt(_scratch.data(), storedSize,
+                                        HEADER_SIZE);
+        assert(peeked == storedSize);
+        (void)peeked;
+        stored = _scratch.data();
+    }
+    if (raw) {
+        std::memcpy(destination, stored, size);
+    } else {
+        auto decompressed = _codec.decompress(destination, size, stored,
+                                              storedSize);
+        assert(decompressed == size);
+        (void)decompressed;
+    }
+    _ring.discardBytes(HEADER_SIZE + storedSize);
+    _storedLogicalByteCount -= size;
+}
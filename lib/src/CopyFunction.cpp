@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Implements the copy functions that the ring buffers can use instead of
+ * <tt>std::memcpy()</tt>.
+ */
+
+#include "CopyFunction.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#define HDC_RINGBUFFER_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define HDC_RINGBUFFER_AVX 1
+#include <immintrin.h>
+#endif
+#endif
+
+using namespace std;
+
+namespace {
+
+/** The unit that the streaming loops copy. */
+const std::size_t LINE_SIZE = 64;
+
+#if defined(HDC_RINGBUFFER_SSE2)
+
+/**
+ * Copies the head of the destination up to the next cache line boundary with
+ * <tt>std::memcpy()</tt> and returns the number of bytes copied.
+ */
+std::size_t copyHead(char *destination, const char *source,
+                     std::size_t count) {
+    auto misalignment = reinterpret_cast<std::uintptr_t>(destination) %
+                        LINE_SIZE;
+    auto n = misalignment == 0 ? 0 : LINE_SIZE - misalignment;
+    n = n < count ? n : count;
+    std::memcpy(destination, source, n);
+    return n;
+}
+
+void nonTemporalCopySse2(char *destination, const char *source,
+                         std::size_t count) {
+    auto n = copyHead(destination, source, count);
+    destination += n;
+    source += n;
+    count -= n;
+    for (; count >= LINE_SIZE; count -= LINE_SIZE) {
+        auto from = reinterpret_cast<const __m128i *>(source);
+        auto to = reinterpret_cast<__m128i *>(destination);
+        auto a = _mm_loadu_si128(from);
+        auto b = _mm_loadu_si128(from + 1);
+        auto c = _mm_loadu_si128(from + 2);
+        auto d = _mm_loadu_si128(from + 3);
+        _mm_stream_si128(to, a);
+        _mm_stream_si128(to + 1, b);
+        _mm_stream_si128(to + 2, c);
+        _mm_stream_si128(to + 3, d);
+        destination += LINE_SIZE;
+        source += LINE_SIZE;
+    }
+    std::memcpy(destination, source, count);
+    _mm_sfence();
+}
+
+#endif
+
+#if defined(HDC_RINGBUFFER_AVX)
+
+__attribute__((target("avx"))) void
+nonTemporalCopyAvx(char *destination, const char *source, std::size_t count) {
+    auto n = copyHead(destination, source, count);
+    destination += n;
+    source += n;
+    count -= n;
+    for (; count >= LINE_SIZE; count -= LINE_SIZE) {
+        auto from = reinterpret_cast<const __m256i *>(source);
+        auto to = reinterpret_cast<__m256i *>(destination);
+        auto a = _mm256_loadu_si256(from);
+        auto b = _mm256_loadu_si256(from + 1);
+        _mm256_stream_si256(to, a);
+        _mm256_stream_si256(to + 1, b);
+        destination += LINE_SIZE;
+        source += LINE_SIZE;
+    }
+    std::memcpy(destination, source, count);
+    _mm_sfence();
+}
+
+#endif
+
+#if !defined(HDC_RINGBUFFER_SSE2)
+
+void copyMemcpy(char *destination, const char *source, std::size_t count) {
+    std::memcpy(destination, source, count);
+}
+
+#endif
+
+typedef void (*CopyKernel)(char *, const char *, std::size_t);
+
+/**
+ * Picks the best kernel for the processor.
+ */
+CopyKernel selectNonTemporalCopy() {
+#if defined(HDC_RINGBUFFER_AVX)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        return nonTemporalCopyAvx;
+    }
+#endif
+#if defined(HDC_RINGBUFFER_SSE2)
+    return nonTemporalCopySse2;
+#else
+    return copyMemcpy;
+#endif
+}
+
+} // namespace
+
+void hdc::ringbuffer::nonTemporalCopy(void *destination, const void *source,
+                                      std::size_t count) {
+    static const auto function = selectNonTemporalCopy();
+    function(static_cast<char *>(destination),
+             static_cast<const char *>(source), count);
+}
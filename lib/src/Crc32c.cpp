@@ -0,0 +1,195 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements the CRC32C checksum functions.
+ */
+
+#include "Crc32c.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HDC_RINGBUFFER_SSE42 1
+#include <nmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define HDC_TARGET_SSE42
+#else
+#define HDC_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define HDC_RINGBUFFER_ARMV8_CRC 1
+#include <arm_acle.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+/**
+ * The kernels work on the inverted checksum, and write to the destination
+ * only if @c COPY is set.
+ */
+typedef std::uint32_t (*Crc32cKernel)(char *, const char *, std::size_t,
+                                      std::uint32_t);
+
+/** The reflected CRC32C polynomial. */
+const std::uint32_t POLYNOMIAL = 0x82f63b78u;
+
+/**
+ * Returns the table that maps a byte to its checksum contribution.
+ */
+const std::uint32_t *getTable() {
+    struct Table {
+        std::uint32_t entries[256];
+
+        Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                auto crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ (crc & 1 ? POLYNOMIAL : 0);
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+    static const Table table;
+    return table.entries;
+}
+
+template <bool COPY>
+std::uint32_t crc32cTable(char *destination, const char *source,
+                          std::size_t size, std::uint32_t crc) {
+    static const auto table = getTable();
+    for (std::size_t i = 0; i < size; ++i) {
+        auto byte = static_cast<unsigned char>(source[i]);
+        crc = table[(crc ^ byte) & 0xff] ^ (crc >> 8);
+        if (COPY) {
+            destination[i] = source[i];
+        }
+    }
+    return crc;
+}
+
+#if defined(HDC_RINGBUFFER_SSE42)
+
+template <bool COPY>
+HDC_TARGET_SSE42 std::uint32_t crc32cSse42(char *destination,
+                                           const char *source,
+                                           std::size_t size,
+                                           std::uint32_t crc) {
+    // Each word is loaded once, then both stored and checksummed.
+    unsigned long long wide = crc;
+    for (; size >= 8; size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, source, 8);
+        wide = _mm_crc32_u64(wide, word);
+        if (COPY) {
+            std::memcpy(destination, &word, 8);
+            destination += 8;
+        }
+        source += 8;
+    }
+    crc = static_cast<std::uint32_t>(wide);
+    for (; size > 0; --size) {
+        crc = _mm_crc32_u8(crc, static_cast<unsigned char>(*source));
+        if (COPY) {
+            *destination++ = *source;
+        }
+        ++source;
+    }
+    return crc;
+}
+
+bool hasSse42() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+#endif
+
+#if defined(HDC_RINGBUFFER_ARMV8_CRC)
+
+template <bool COPY>
+std::uint32_t crc32cArmv8(char *destination, const char *source,
+                          std::size_t size, std::uint32_t crc) {
+    for (; size >= 8; size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, source, 8);
+        crc = __crc32cd(crc, word);
+        if (COPY) {
+            std::memcpy(destination, &word, 8);
+            destination += 8;
+        }
+        source += 8;
+    }
+    for (; size > 0; --size) {
+        crc = __crc32cb(crc, static_cast<std::uint8_t>(*source));
+        if (COPY) {
+            *destination++ = *source;
+        }
+        ++source;
+    }
+    return crc;
+}
+
+#endif
+
+/**
+ * Picks the best kernel for the processor.
+ */
+template <bool COPY> Crc32cKernel selectKernel() {
+#if defined(HDC_RINGBUFFER_SSE42)
+    if (hasSse42()) {
+        return crc32cSse42<COPY>;
+    }
+#elif defined(HDC_RINGBUFFER_ARMV8_CRC)
+    return crc32cArmv8<COPY>;
+#endif
+    return crc32cTable<COPY>;
+}
+
+} // namespace
+
+std::uint32_t hdc::ringbuffer::crc32c(const void *data, std::size_t size,
+                                      std::uint32_t crc) {
+    static const auto kernel = selectKernel<false>();
+    return ~kernel(nullptr, static_cast<const char *>(data), size, ~crc);
+}
+
+std::uint32_t hdc::ringbuffer::copyCrc32c(void *destination,
+                                          const void *source, std::size_t size,
+                                          std::uint32_t crc) {
+    static const auto kernel = selectKernel<true>();
+    return ~kernel(static_cast<char *>(destination),
+                   static_cast<const char *>(source), size, ~crc);
+}
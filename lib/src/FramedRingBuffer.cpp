@@ -0,0 +1,212 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class FramedRingBuffer.
+ */
+
+#include "FramedRingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Encodes @p size as an unsigned LEB128 varint.
+ *
+ * @return
+ * The number of bytes written to @p header.
+ */
+std::size_t encodeHeader(std::size_t size, char *header) {
+    std::size_t n = 0;
+    while (size >= 0x80) {
+        header[n++] = static_cast<char>((size & 0x7f) | 0x80);
+        size >>= 7;
+    }
+    header[n++] = static_cast<char>(size);
+    return n;
+}
+
+/**
+ * Returns byte @p i of @p spans.
+ */
+unsigned char byteAt(const ConstSpanPair &spans, std::size_t i) {
+    return static_cast<unsigned char>(
+        i < spans.first.size ? spans.first.data[i]
+                             : spans.second.data[i - spans.first.size]);
+}
+
+} // namespace
+
+const std::size_t FramedRingBuffer::MAX_HEADER_SIZE;
+
+std::size_t FramedRingBuffer::getFramedSize(std::size_t size) {
+    char header[MAX_HEADER_SIZE];
+    return encodeHeader(size, header) + size;
+}
+
+bool FramedRingBuffer::writeMessage(const void *message, std::size_t size) {
+    assert(message != nullptr || size == 0);
+
+    char header[MAX_HEADER_SIZE];
+    auto headerSize = encodeHeader(size, header);
+    auto writable = _ring.getWritableByteCount();
+    if (writable < headerSize || writable - headerSize < size) {
+        return false;
+    }
+
+    // Header and payload go in together, so that the header never becomes
+    // readable without its payload.
+    ConstSpan parts[] = {{header, headerSize},
+                         {static_cast<const char *>(message), size}};
+    auto written = _ring.writeBatch(parts, size == 0 ? 1 : 2);
+    assert(written == (size == 0 ? 1u : 2u));
+    (void)written;
+    return true;
+}
+
+bool FramedRingBuffer::overwriteMessage(const void *message,
+                                        std::size_t size) {
+    auto framedSize = getFramedSize(size);
+    auto capacity = _ring.getReadableByteCount() + _ring.getWritableByteCount();
+    if (framedSize < size || framedSize > capacity) {
+        return false;
+    }
+
+    while (_ring.getWritableByteCount() < framedSize) {
+        auto skipped = skipMessage();
+        assert(skipped);
+        (void)skipped;
+        ++_droppedMessageCount;
+    }
+    auto written = writeMessage(message, size);
+    assert(written);
+    (void)written;
+    return true;
+}
+
+bool FramedRingBuffer::peekMessageSize(std::size_t &size) const {
+    ConstSpanPair spans;
+    std::size_t headerSize;
+    return _findMessage(spans, headerSize, size);
+}
+
+bool FramedRingBuffer::peekMessage(void *destination, std::size_t capacity,
+                                   std::size_t &size) const {
+    assert(destination != nullptr || capacity == 0);
+
+    ConstSpanPair spans;
+    std::size_t headerSize;
+    if (!_findMessage(spans, headerSize, size) || size > capacity) {
+        return false;
+    }
+    if (size != 0) {
+        detail::copyFromSpans(spans, headerSize,
+                              static_cast<char *>(destination), size);
+    }
+    return true;
+}
+
+bool FramedRingBuffer::peekMessageSpans(ConstSpanPair &spans) const {
+    ConstSpanPair readable;
+    std::size_t headerSize;
+    std::size_t size;
+    if (!_findMessage(readable, headerSize, size)) {
+        return false;
+    }
+
+    // Trim the readable bytes down to the payload.
+    if (headerSize < readable.first.size) {
+        spans.first.data = readable.first.data + headerSize;
+        spans.first.size = std::min(size, readable.first.size - headerSize);
+        spans.second.data = readable.second.data;
+        spans.second.size = size - spans.first.size;
+    } else {
+        spans.first.data = readable.second.data +
+                           (headerSize - readable.first.size);
+        spans.first.size = size;
+        spans.second.data = readable.second.data;
+        spans.second.size = 0;
+    }
+    return true;
+}
+
+bool FramedRingBuffer::readMessage(void *destination, std::size_t capacity,
+                                   std::size_t &size) {
+    assert(destination != nullptr || capacity == 0);
+
+    ConstSpanPair spans;
+    std::size_t headerSize;
+    if (!_findMessage(spans, headerSize, size) || size > capacity) {
+        return false;
+    }
+    if (size != 0) {
+        detail::copyFromSpans(spans, headerSize,
+                              static_cast<char *>(destination), size);
+    }
+    _ring.consume(headerSize + size);
+    return true;
+}
+
+bool FramedRingBuffer::skipMessage() {
+    ConstSpanPair spans;
+    std::size_t headerSize;
+    std::size_t size;
+    if (!_findMessage(spans, headerSize, size)) {
+        return false;
+    }
+    _ring.consume(headerSize + size);
+    return true;
+}
+
+bool FramedRingBuffer::_findMessage(ConstSpanPair &spans,
+                                    std::size_t &headerSize,
+                                    std::size_t &size) const {
+    spans = _ring.readableSpans();
+    auto readable = spans.size();
+
+    size = 0;
+    for (headerSize = 0; headerSize < MAX_HEADER_SIZE;) {
+        if (headerSize == readable) {
+            // Only writeMessage() adds bytes, and it never leaves a header
+            // without its payload.
+            assert(readable == 0);
+            return false;
+        }
+        auto byte = byteAt(spans, headerSize);
+        size |= static_cast<std::size_t>(byte & 0x7f) << (7 * headerSize);
+        ++headerSize;
+        if ((byte & 0x80) == 0) {
+            assert(size <= readable - headerSize);
+            return true;
+        }
+    }
+    assert(false && "malformed message header");
+    return false;
+}
@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class GrowableRingBuffer.
+ */
+
+#include "GrowableRingBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+GrowableRingBuffer::GrowableRingBuffer(std::size_t initialSize,
+                                       std::size_t maximumSize)
+    : _buffer(new char[initialSize]), _size(initialSize),
+      _maximumSize(maximumSize), _ring(_buffer.get(), initialSize) {
+    assert(initialSize <= maximumSize);
+}
+
+bool GrowableRingBuffer::reserve(std::size_t count) {
+    auto writable = _ring.getWritableByteCount();
+    if (count <= writable) {
+        return true;
+    }
+    auto needed = count - writable;
+    if (needed > _maximumSize - _size) {
+        return false;
+    }
+
+    // Doubling keeps the number of times each byte is moved amortized O(1).
+    auto size = _size + std::max(needed, std::min(_size, _maximumSize - _size));
+    std::unique_ptr<char[]> buffer(new (std::nothrow) char[size]);
+    if (!buffer) {
+        return false;
+    }
+    _ring.resize(buffer.get(), size);
+    _buffer = std::move(buffer);
+    _size = size;
+    return true;
+}
@@ -0,0 +1,317 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class JournalRingBuffer.
+ */
+
+#include "JournalRingBuffer.h"
+
+#include "Crc32c.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+JournalRingBuffer::JournalRingBuffer(const char *path, std::size_t capacity)
+    : _memory(nullptr), _capacity(capacity), _header(nullptr), _epoch(0),
+      _committedOffset(0), _committedCount(0), _dirty(0), _recovered(false)
+#if defined(_WIN32)
+      ,
+      _file(nullptr)
+#endif
+{
+    assert(path != nullptr);
+    assert(capacity > 0);
+
+    bool created = false;
+    if (capacity > numeric_limits<std::size_t>::max() - HEADER_SIZE ||
+        !_open(path, HEADER_SIZE + capacity, created)) {
+        return;
+    }
+    _header = reinterpret_cast<_Header *>(_memory);
+    _ring.reset(new RingBuffer(_memory + HEADER_SIZE, capacity));
+
+    // A file without a magic number was never completely formatted, so
+    // there is nothing in it to recover.
+    _recovered = !created && _header->magic != 0;
+    if (!(_recovered ? _recover() : _format())) {
+        _ring.reset();
+        _unmap();
+    }
+}
+
+JournalRingBuffer::~JournalRingBuffer() { _unmap(); }
+
+std::size_t JournalRingBuffer::getWritableByteCount() const {
+    _assertValid();
+
+    auto writable = _ring->getWritableByteCount();
+    if (_committedCount == 0) {
+        return writable;
+    }
+    // The ring buffer writes after its readable bytes, or from the start of
+    // the buffer once it has been emptied. Either way, it may only write up
+    // to the start of the committed bytes, and not at all from inside them.
+    auto spans = _ring->readableSpans();
+    std::size_t offset = 0;
+    if (spans.size() != 0) {
+        offset = static_cast<std::size_t>(spans.first.data -
+                                          (_memory + HEADER_SIZE));
+        offset = (offset + spans.size()) % _capacity;
+    }
+    auto fromCommitted = (offset + _capacity - _committedOffset) % _capacity;
+    if (fromCommitted < _committedCount) {
+        return 0;
+    }
+    return std::min(writable, _capacity - fromCommitted);
+}
+
+void JournalRingBuffer::commit() {
+    _assertValid();
+
+    auto spans = _ring->readableSpans();
+    auto epoch = _epoch + 1;
+    auto &slot = _header->slots[epoch % 2];
+    // The data must be in the mapping before the slot that points at it.
+    atomic_signal_fence(memory_order_release);
+    slot.epoch = epoch;
+    slot.offset = spans.size() == 0
+                      ? 0
+                      : static_cast<std::uint64_t>(spans.first.data -
+                                                   (_memory + HEADER_SIZE));
+    slot.count = spans.size();
+    slot.reserved = 0;
+    slot.crc = _checksum(slot);
+    _epoch = epoch;
+    _committedOffset = static_cast<std::size_t>(slot.offset);
+    _committedCount = static_cast<std::size_t>(slot.count);
+}
+
+bool JournalRingBuffer::flush() {
+    _assertValid();
+
+    // The dirty bytes are the last readable ones. Write them back before the
+    // header, so that the header never points at data that is not in the
+    // file.
+    auto spans = _ring->readableSpans();
+    auto dirty = getDirtyByteCount();
+    auto second = std::min(dirty, spans.second.size);
+    auto first = dirty - second;
+    if (!_sync(spans.first.data + spans.first.size - first, first) ||
+        !_sync(spans.second.data + spans.second.size - second, second)) {
+        return false;
+    }
+    commit();
+    if (!_sync(_memory, sizeof(_Header))) {
+        return false;
+    }
+    _dirty = 0;
+    return true;
+}
+
+std::uint32_t JournalRingBuffer::_checksum(const _Slot &slot) {
+    return crc32c(&slot, offsetof(_Slot, crc));
+}
+
+bool JournalRingBuffer::_format() {
+    static_assert(sizeof(_Header) <= HEADER_SIZE, "The header must fit");
+
+    // Publish the magic number only once the rest of the header is in the
+    // file.
+    _header->magic = 0;
+    _header->version = VERSION;
+    _header->capacity = _capacity;
+    std::memset(_header->slots, 0, sizeof(_header->slots));
+    commit();
+    if (!_sync(_memory, sizeof(_Header))) {
+        return false;
+    }
+    _header->magic = MAGIC;
+    return _sync(_memory, sizeof(_Header));
+}
+
+bool JournalRingBuffer::_recover() {
+    if (_header->magic != MAGIC || _header->version != VERSION ||
+        _header->capacity != _capacity) {
+        return false;
+    }
+    // A crash during a commit leaves at most one slot torn.
+    const _Slot *newest = nullptr;
+    for (const auto &slot : _header->slots) {
+        if (slot.crc == _checksum(slot) && slot.offset < _capacity &&
+            slot.count <= _capacity &&
+            (newest == nullptr || slot.epoch > newest->epoch)) {
+            newest = &slot;
+        }
+    }
+    if (newest == nullptr) {
+        return false;
+    }
+    _ring->restore(static_cast<std::size_t>(newest->offset),
+                   static_cast<std::size_t>(newest->count));
+    _epoch = newest->epoch;
+    _committedOffset = static_cast<std::size_t>(newest->offset);
+    _committedCount = static_cast<std::size_t>(newest->count);
+    return true;
+}
+
+void JournalRingBuffer::_assertValid() const {
+    assert(_ring != nullptr);
+    assert(_memory != nullptr);
+}
+
+#if defined(_WIN32)
+
+bool JournalRingBuffer::_open(const char *path, std::size_t size,
+                              bool &created) {
+    auto file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    created = fileSize.QuadPart == 0;
+    if (!created && static_cast<unsigned long long>(fileSize.QuadPart) !=
+                        static_cast<unsigned long long>(size)) {
+        CloseHandle(file);
+        return false;
+    }
+    // Mapping more than the file holds extends it with zeros.
+    auto mapping = CreateFileMappingA(
+        file, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+        static_cast<DWORD>(size), nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    auto memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    // The view keeps the mapping alive.
+    CloseHandle(mapping);
+    if (memory == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    _memory = static_cast<char *>(memory);
+    _file = file;
+    return true;
+}
+
+bool JournalRingBuffer::_sync(const char *data, std::size_t count) {
+    return count == 0 ||
+           (FlushViewOfFile(data, count) && FlushFileBuffers(_file));
+}
+
+void JournalRingBuffer::_unmap() {
+    if (_memory != nullptr) {
+        UnmapViewOfFile(_memory);
+        CloseHandle(_file);
+        _memory = nullptr;
+        _file = nullptr;
+    }
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+bool JournalRingBuffer::_open(const char *path, std::size_t size,
+                              bool &created) {
+    auto fd = open(path, O_RDWR | O_CREAT, 0600);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return false;
+    }
+    created = status.st_size == 0;
+    if (created ? ftruncate(fd, static_cast<off_t>(size)) != 0
+                : static_cast<unsigned long long>(status.st_size) !=
+                      static_cast<unsigned long long>(size)) {
+        close(fd);
+        return false;
+    }
+    auto memory =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the file open.
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    _memory = static_cast<char *>(memory);
+    return true;
+}
+
+bool JournalRingBuffer::_sync(const char *data, std::size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    // msync() takes whole pages, and the mapping starts on a page boundary.
+    auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    auto begin = static_cast<std::size_t>(data - _memory);
+    auto end = begin + count;
+    begin -= begin % pageSize;
+    return msync(_memory + begin, end - begin, MS_SYNC) == 0;
+}
+
+void JournalRingBuffer::_unmap() {
+    if (_memory != nullptr) {
+        munmap(_memory, HEADER_SIZE + _capacity);
+        _memory = nullptr;
+    }
+}
+
+#else
+
+bool JournalRingBuffer::_open(const char *, std::size_t, bool &) {
+    return false;
+}
+
+bool JournalRingBuffer::_sync(const char *, std::size_t) { return false; }
+
+void JournalRingBuffer::_unmap() {}
+
+#endif
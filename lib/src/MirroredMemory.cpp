@@ -0,0 +1,251 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class MirroredMemory.
+ */
+
+#include "MirroredMemory.h"
+
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if !defined(__linux__)
+#include <atomic>
+#include <cstdio>
+#endif
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+#if defined(_WIN32)
+
+/**
+ * Maps @p size bytes of a new page-file-backed section twice, back to back.
+ *
+ * Reserves a placeholder for both views, splits it in two and replaces each
+ * half with a view of the same section.
+ */
+char *mapMirrored(std::size_t size) {
+    auto placeholder = static_cast<char *>(
+        VirtualAlloc2(nullptr, nullptr, 2 * size,
+                      MEM_RESERVE | MEM_RESERVE_PLACEHOLDER, PAGE_NOACCESS,
+                      nullptr, 0));
+    if (placeholder == nullptr) {
+        return nullptr;
+    }
+    if (!VirtualFree(placeholder, size,
+                     MEM_RELEASE | MEM_PRESERVE_PLACEHOLDER)) {
+        VirtualFree(placeholder, 0, MEM_RELEASE);
+        return nullptr;
+    }
+
+    auto section = CreateFileMappingW(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+        static_cast<DWORD>(size), nullptr);
+    if (section == nullptr) {
+        VirtualFree(placeholder, 0, MEM_RELEASE);
+        VirtualFree(placeholder + size, 0, MEM_RELEASE);
+        return nullptr;
+    }
+
+    auto first = MapViewOfFile3(section, nullptr, placeholder, 0, size,
+                                MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE,
+                                nullptr, 0);
+    auto second = MapViewOfFile3(section, nullptr, placeholder + size, 0,
+                                 size, MEM_REPLACE_PLACEHOLDER, PAGE_READWRITE,
+                                 nullptr, 0);
+    // The views keep the section alive.
+    CloseHandle(section);
+
+    if (first == nullptr || second == nullptr) {
+        if (first != nullptr) {
+            UnmapViewOfFile(first);
+        } else {
+            VirtualFree(placeholder, 0, MEM_RELEASE);
+        }
+        if (second != nullptr) {
+            UnmapViewOfFile(second);
+        } else {
+            VirtualFree(placeholder + size, 0, MEM_RELEASE);
+        }
+        return nullptr;
+    }
+    return placeholder;
+}
+
+void unmapMirrored(char *buffer, std::size_t size) {
+    UnmapViewOfFile(buffer);
+    UnmapViewOfFile(buffer + size);
+}
+
+std::size_t granularity() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+/**
+ * Returns a file descriptor for @p size bytes of anonymous shared memory, or
+ * -1 on failure.
+ */
+int createSharedMemory(std::size_t size) {
+#if defined(__linux__)
+    auto fd = memfd_create("hdc-ringbuffer", MFD_CLOEXEC);
+#else
+    // No anonymous shared memory: create a uniquely named object and unlink
+    // it straight away.
+    static std::atomic<unsigned> counter(0);
+    char name[64];
+    std::snprintf(name, sizeof(name), "/hdc-ringbuffer-%ld-%u",
+                  static_cast<long>(getpid()), counter++);
+    auto fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd != -1) {
+        shm_unlink(name);
+    }
+#endif
+    if (fd == -1) {
+        return -1;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Maps @p size bytes of new shared memory twice, back to back.
+ *
+ * Reserves address space for both mappings, then maps the same memory over
+ * each half.
+ */
+char *mapMirrored(std::size_t size) {
+    auto fd = createSharedMemory(size);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    auto reserved = mmap(nullptr, 2 * size, PROT_NONE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+    auto buffer = static_cast<char *>(reserved);
+
+    auto first = mmap(buffer, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_FIXED, fd, 0);
+    auto second = mmap(buffer + size, size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED, fd, 0);
+    // The mappings keep the memory alive.
+    close(fd);
+
+    if (first == MAP_FAILED || second == MAP_FAILED) {
+        munmap(buffer, 2 * size);
+        return nullptr;
+    }
+    return buffer;
+}
+
+void unmapMirrored(char *buffer, std::size_t size) {
+    munmap(buffer, 2 * size);
+}
+
+std::size_t granularity() {
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+#else
+
+char *mapMirrored(std::size_t) { return nullptr; }
+
+void unmapMirrored(char *, std::size_t) {}
+
+std::size_t granularity() { return 1; }
+
+#endif
+
+} // namespace
+
+MirroredMemory::MirroredMemory(std::size_t minimumSize)
+    : _buffer(nullptr), _size(0) {
+    auto unit = getGranularity();
+    if (minimumSize == 0 ||
+        minimumSize > numeric_limits<std::size_t>::max() / 2 - unit) {
+        return;
+    }
+    auto size = (minimumSize + unit - 1) / unit * unit;
+    _buffer = mapMirrored(size);
+    if (_buffer != nullptr) {
+        _size = size;
+    }
+}
+
+MirroredMemory::~MirroredMemory() { _unmap(); }
+
+MirroredMemory::MirroredMemory(MirroredMemory &&other) noexcept
+    : _buffer(other._buffer), _size(other._size) {
+    other._buffer = nullptr;
+    other._size = 0;
+}
+
+MirroredMemory &MirroredMemory::operator=(MirroredMemory &&other) noexcept {
+    if (this != &other) {
+        _unmap();
+        _buffer = other._buffer;
+        _size = other._size;
+        other._buffer = nullptr;
+        other._size = 0;
+    }
+    return *this;
+}
+
+std::size_t MirroredMemory::getGranularity() {
+    static const auto unit = granularity();
+    return unit;
+}
+
+void MirroredMemory::_unmap() {
+    if (_buffer != nullptr) {
+        unmapMirrored(_buffer, _size);
+        _buffer = nullptr;
+        _size = 0;
+    }
+}
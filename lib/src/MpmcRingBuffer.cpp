@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class MpmcRingBuffer.
+ */
+
+#include "MpmcRingBuffer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+/**
+ * @class hdc::ringbuffer::MpmcRingBuffer
+ *
+ * @internal
+ *
+ * # Internal Details
+ *
+ * This is Dmitry Vyukov's bounded MPMC queue. @c _enqueue and @c _dequeue are
+ * free-running positions. Position @c p maps to slot <tt>p & _mask</tt>, and
+ * each slot carries a sequence number that says which position it is ready
+ * for:
+ * - <tt>sequence == 2 * p</tt>: the slot is free for the producer that claims
+ *   enqueue position @c p.
+ * - <tt>sequence == 2 * p + 1</tt>: the slot holds the message for the
+ *   consumer that claims dequeue position @c p.
+ *
+ * A producer claims a position by advancing @c _enqueue with a
+ * compare-and-swap, copies its message into the slot (which no other thread
+ * touches at that point) and then publishes it by storing
+ * <tt>2 * p + 1</tt> into the sequence with release semantics. A consumer
+ * does the same with @c _dequeue, then frees the slot for the next lap by
+ * storing <tt>2 * (p + slot count)</tt>. Doubling the positions keeps the two
+ * states apart even with a single slot, where the original
+ * <tt>p + 1</tt> would mean both "holds the message for @c p" and "free for
+ * <tt>p + 1</tt>". A sequence behind the position means the queue is
+ * full (for a producer) or empty (for a consumer). A sequence ahead of it
+ * means another thread claimed the position first, so the thread reloads the
+ * position and tries again.
+ *
+ * Producers contend only on @c _enqueue and consumers only on @c _dequeue,
+ * which sit on separate cache lines. The copies themselves run in parallel.
+ * The slot count is a power of two, so that positions map to slots
+ * consistently when they wrap around.
+ */
+
+MpmcRingBuffer::MpmcRingBuffer(void *buffer, std::size_t size,
+                               std::size_t slotSize)
+    : _buffer(static_cast<char *>(buffer)), _slotSize(slotSize),
+      _stride(_getStride(slotSize)), _mask(0), _enqueue(0), _dequeue(0) {
+    assert(reinterpret_cast<std::uintptr_t>(buffer) % alignof(_Slot) == 0);
+    assert(size >= _stride);
+
+    // Use the largest power-of-two number of slots that fits.
+    std::size_t count = 1;
+    while (count <= size / _stride / 2) {
+        count *= 2;
+    }
+    _mask = count - 1;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto slot = new (_buffer + i * _stride) _Slot;
+        slot->sequence.store(2 * i, memory_order_relaxed);
+        slot->size = 0;
+    }
+    _assertValid();
+}
+
+bool MpmcRingBuffer::tryWrite(const void *message, std::size_t size) {
+    _assertValid();
+
+    assert(message != nullptr || size == 0);
+    assert(size <= _slotSize);
+
+    auto position = _enqueue.load(memory_order_relaxed);
+    _Slot *slot;
+    for (;;) {
+        slot = _getSlot(position);
+        auto sequence = slot->sequence.load(memory_order_acquire);
+        auto difference = static_cast<std::intptr_t>(sequence - 2 * position);
+        if (difference == 0) {
+            // The slot is free. Claim it.
+            if (_enqueue.compare_exchange_weak(position, position + 1,
+                                               memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot still holds the message from the previous lap.
+            return false;
+        } else {
+            // Another producer claimed this position first.
+            position = _enqueue.load(memory_order_relaxed);
+        }
+    }
+
+    if (size != 0) {
+        std::memcpy(reinterpret_cast<char *>(slot + 1), message, size);
+    }
+    slot->size = size;
+    slot->sequence.store(2 * position + 1, memory_order_release);
+    return true;
+}
+
+bool MpmcRingBuffer::tryRead(void *destination, std::size_t capacity,
+                             std::size_t &size) {
+    _assertValid();
+
+    assert(destination != nullptr || capacity == 0);
+
+    auto position = _dequeue.load(memory_order_relaxed);
+    _Slot *slot;
+    for (;;) {
+        slot = _getSlot(position);
+        auto sequence = slot->sequence.load(memory_order_acquire);
+        auto difference =
+            static_cast<std::intptr_t>(sequence - (2 * position + 1));
+        if (difference == 0) {
+            // The slot holds a message. Claim it.
+            if (_dequeue.compare_exchange_weak(position, position + 1,
+                                               memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The slot has not been written on this lap yet.
+            return false;
+        } else {
+            // Another consumer claimed this position first.
+            position = _dequeue.load(memory_order_relaxed);
+        }
+    }
+
+    size = slot->size;
+    auto n = size < capacity ? size : capacity;
+    if (n != 0) {
+        std::memcpy(destination, reinterpret_cast<char *>(slot + 1), n);
+    }
+    slot->sequence.store(2 * (position + _mask + 1), memory_order_release);
+    return true;
+}
+
+void MpmcRingBuffer::_assertValid() const {
+    assert(_buffer != nullptr);
+    assert(((_mask + 1) & _mask) == 0);
+    assert(_stride >= sizeof(_Slot) + _slotSize);
+}
@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class PowerOfTwoRingBuffer.
+ */
+
+#include "PowerOfTwoRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+/**
+ * @class hdc::ringbuffer::PowerOfTwoRingBuffer
+ *
+ * @internal
+ *
+ * # Internal Details
+ *
+ * @c _read and @c _write count the bytes ever read and written. They never
+ * reset, except that clear() moves @c _read up to @c _write. These conditions
+ * are always true:
+ * - <tt>_write - _read <= _mask + 1</tt>
+ * - <tt>_mask + 1</tt> is a power of two
+ *
+ * The byte counted by @c i lives at offset <tt>i & _mask</tt> in the buffer.
+ * Since the size divides 2<sup>64</sup>, this stays correct when the counters
+ * wrap around, and <tt>_write - _read</tt> is always the number of readable
+ * bytes. There are no special empty or full states.
+ */
+
+std::size_t PowerOfTwoRingBuffer::writeBytes(const void *source,
+                                             std::size_t count) {
+    assert(source != nullptr);
+
+    count = std::min(count, getWritableByteCount());
+
+    // Write up to end of buffer, then wrap around to beginning of buffer.
+    auto offset = static_cast<std::size_t>(_write) & _mask;
+    auto n = std::min(count, getSize() - offset);
+    std::memcpy(_buffer + offset, source, n);
+    std::memcpy(_buffer, static_cast<const char *>(source) + n, count - n);
+
+    _write += count;
+    return count;
+}
+
+SpanPair PowerOfTwoRingBuffer::reserveWrite(std::size_t count) {
+    count = std::min(count, getWritableByteCount());
+    auto offset = static_cast<std::size_t>(_write) & _mask;
+    auto n = std::min(count, getSize() - offset);
+    SpanPair spans = {{_buffer + offset, n}, {_buffer, count - n}};
+    return spans;
+}
+
+ConstSpanPair PowerOfTwoRingBuffer::readableSpans() const {
+    auto count = getReadableByteCount();
+    auto offset = static_cast<std::size_t>(_read) & _mask;
+    auto n = std::min(count, getSize() - offset);
+    ConstSpanPair spans = {{_buffer + offset, n}, {_buffer, count - n}};
+    return spans;
+}
+
+std::size_t PowerOfTwoRingBuffer::_peekBytes(void *destination,
+                                             std::size_t count,
+                                             std::size_t where) const {
+    auto readable = getReadableByteCount();
+    if (where >= readable) {
+        return 0;
+    }
+    count = std::min(count, readable - where);
+
+    // Read up to end of buffer, then wrap around to beginning of buffer.
+    auto offset = static_cast<std::size_t>(_read + where) & _mask;
+    auto n = std::min(count, getSize() - offset);
+    std::memcpy(destination, _buffer + offset, n);
+    std::memcpy(static_cast<char *>(destination) + n, _buffer, count - n);
+    return count;
+}
+
+void PowerOfTwoRingBuffer::_assertValid() const {
+    assert(_buffer != nullptr);
+    assert(_mask + 1 > 0);
+    assert((_mask & (_mask + 1)) == 0);
+    assert(_write - _read <= _mask + 1);
+}
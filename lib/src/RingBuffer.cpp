@@ -28,9 +28,11 @@ SOFTWARE.
  */
 
 #include "RingBuffer.h"
+#include "ByteSearch.h"
 
-#include <algorithm>
-#include <cstring>
+#if !defined(HDC_RINGBUFFER_HEADER_ONLY)
+#include "RingBuffer.ipp"
+#endif
 
 using namespace std;
 using namespace hdc::ringbuffer;
@@ -223,213 +225,59 @@ using namespace hdc::ringbuffer;
  */
 // clang-format on
 
-std::size_t RingBuffer::writeBytes(const void *source, std::size_t count) {
-    _assertValid();
+const std::size_t RingBuffer::NOT_FOUND;
 
-    assert(source != nullptr);
+constexpr bool RingBufferStats::ENABLED;
 
-    if (count == 0 || isFull()) {
-        return 0;
-    }
-
-    auto original_count = count;
-
-    if (_read < _write) {
-        // clang-format off
-        // The following states are possible here:
-        //   Non-Full, Read Beginning
-        //         0                                    _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+
-        //     | First |  ...  | Last  | Empty |  ...  | Empty |
-        //     +-------+-------+-------+-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //       _read                  _write
-        //   Wrap Write
-        //         0                                                            _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //     | Empty |  ...  | Empty | First |  ...  | Last  | Empty |  ...  | Empty |
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //                                 ^                       ^
-        //                                 |                       |
-        //                               _read                  _write
-        // clang-format on
-
-        // Write up to count bytes up to end of buffer.
-        auto n = std::min(count, _size - _write);
-        std::memcpy(_buffer + _write, source, n);
-        count -= n;
-        _write += n;
-        source = static_cast<const char *>(source) + n;
-
-        // Wrap around if buffer not full.
-        if (_write == _size && _read > 0) {
-            _write = 0;
+std::size_t RingBuffer::findByte(std::uint8_t value, std::size_t from) const {
+    auto spans = readableSpans();
+    if (from < spans.first.size) {
+        auto begin = spans.first.data + from;
+        auto end = spans.first.data + spans.first.size;
+        auto found = detail::findByte(begin, end, value);
+        if (found != end) {
+            return static_cast<std::size_t>(found - spans.first.data);
         }
+        from = spans.first.size;
     }
-
-    if (_read > _write) {
-        // clang-format off
-        // The following states are possible here:
-        //   Empty:
-        //         0            _size-1  _size
-        //     +-------+-------+-------+
-        //     | Empty |  ...  | Empty |
-        //     +-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //      _write                   _read
-        //   Non-Empty, Write Beginning:
-        //         0                                    _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+
-        //     | Empty |  ...  | Empty | First |  ...  | Last  |
-        //     +-------+-------+-------+-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //      _write                   _read
-        //   Non-Full, Wrap Read:
-        //       0                                                              _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //     | Valid |  ...  | Last  | Empty |  ...  | Empty | First |  ...  | Valid |
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //                                 ^                       ^
-        //                                 |                       |
-        //                              _write                   _read
-        // clang-format on
-
-        // Write up to count bytes up to read location.
-        auto n = std::min(count, _read - _write);
-        std::memcpy(_buffer + _write, source, n);
-        _write += n;
-        count -= n;
-
-        if (_write == _read) {
-            // Buffer full.
-            _write = _size;
-        }
-
-        if (_read == _size) {
-            // Buffer was empty.
-            // We've just written to beginning of buffer.
-            // Make next read() start at beginning of buffer.
-            _read = 0;
+    if (from < spans.size()) {
+        auto begin = spans.second.data + (from - spans.first.size);
+        auto end = spans.second.data + spans.second.size;
+        auto found = detail::findByte(begin, end, value);
+        if (found != end) {
+            return spans.first.size +
+                   static_cast<std::size_t>(found - spans.second.data);
         }
     }
-
-    return original_count - count;
+    return NOT_FOUND;
 }
 
-std::size_t RingBuffer::_readBytes(void *destination, std::size_t count,
-                                   std::size_t &read, std::size_t &write) {
-    _assertValid();
-
-    if (count == 0 || isEmpty()) {
-        return 0;
-    }
-    auto original_count = count;
-
-    if (read > write || write == _size) {
-        // clang-format off
-        // The following states are possible here:
-        //   Full, Read Beginning:
-        //         0            _size-1  _size
-        //     +-------+-------+-------+
-        //     | First |  ...  | Last  |
-        //     +-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //       read                    write
-        //   Full, Read Middle:
-        //         0                                    _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+
-        //     | Valid |  ...  | Last  | First |  ...  | Valid |
-        //     +-------+-------+-------+-------+-------+-------+
-        //                                 ^                       ^
-        //                                 |                       |
-        //                               read                    write
-        //   Non-Empty, Write Beginning:
-        //         0                                    _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+
-        //     | Empty |  ...  | Empty | First |  ...  | Last  |
-        //     +-------+-------+-------+-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //       write                   read
-        //   Non-Full, Wrap Read:
-        //       0                                                              _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //     | Valid |  ...  | Last  | Empty |  ...  | Empty | First |  ...  | Valid |
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //                                 ^                       ^
-        //                                 |                       |
-        //                               write                   read
-        // clang-format on
-
-        if (write == _size) {
-            // Buffer full.
-            // Reading will free up space for writing.
-            // Make next write() start at current read location.
-            write = read;
+std::size_t RingBuffer::findBytes(const void *pattern, std::size_t size,
+                                  std::size_t from) const {
+    HDC_RINGBUFFER_ASSERT(pattern != nullptr);
+    HDC_RINGBUFFER_ASSERT(size > 0);
+
+    auto bytes = static_cast<const char *>(pattern);
+    auto spans = readableSpans();
+    auto readable = spans.size();
+    // Find each occurrence of the first byte, then compare the rest, which
+    // may continue past the end of the buffer.
+    for (auto at = findByte(static_cast<std::uint8_t>(bytes[0]), from);
+         at != NOT_FOUND && size <= readable - at;
+         at = findByte(static_cast<std::uint8_t>(bytes[0]), at + 1)) {
+        std::size_t i = 1;
+        for (; i < size; ++i) {
+            auto offset = at + i;
+            auto byte = offset < spans.first.size
+                            ? spans.first.data[offset]
+                            : spans.second.data[offset - spans.first.size];
+            if (byte != bytes[i]) {
+                break;
+            }
         }
-
-        // Read up to count bytes up to end of buffer.
-        auto n = std::min(count, _size - read);
-        if (destination != nullptr) {
-            std::memcpy(destination, _buffer + read, n);
-        }
-        count -= n;
-        read += n;
-        destination = static_cast<char *>(destination) + n;
-
-        // Wrap around reading if buffer not empty.
-        if (read == _size && write > 0) {
-            read = 0;
+        if (i == size) {
+            return at;
         }
     }
-
-    if (read < write) {
-        // clang-format off
-        // The following states are possible here:
-        //   Non-Full, Read Beginning
-        //        0                                    _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+
-        //     | First |  ...  | Last  | Empty |  ...  | Empty |
-        //     +-------+-------+-------+-------+-------+-------+
-        //         ^                       ^
-        //         |                       |
-        //       read                    write
-        //   Wrap Write
-        //         0                                                            _size-1  _size
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //     | Empty |  ...  | Empty | First |  ...  | Last  | Empty |  ...  | Empty |
-        //     +-------+-------+-------+-------+-------+-------+-------+-------+-------+
-        //                                 ^                       ^
-        //                                 |                       |
-        //                               read                    write
-        // clang-format on
-
-        // Read up to count bytes up to write location.
-        auto n = std::min(count, write - read);
-        if (destination != nullptr) {
-            std::memcpy(destination, _buffer + read, n);
-        }
-        count -= n;
-        read += n;
-
-        if (read == write) {
-            // Buffer empty.
-            read = _size;
-            write = 0;
-        }
-    }
-
-    return original_count - count;
+    return NOT_FOUND;
 }
-
-void RingBuffer::_assertValid() const {
-    assert(_buffer != nullptr);
-    assert(_size > 0);
-    assert(_read < _size || (_read == _size && _write == 0));
-    assert(_write <= _size);
-    assert(_read != _write);
-}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements the RingBuffer file descriptor functions.
+ */
+
+#include "RingBufferIo.h"
+
+#include <algorithm>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Fills @p vectors with the free spans of the ring buffer, up to @p max bytes.
+ *
+ * @return
+ * The number of vectors used.
+ */
+int getWritableVectors(RingBuffer &ringBuffer, std::size_t max,
+                       iovec (&vectors)[2]) {
+    auto spans = ringBuffer.reserveWrite(max);
+    vectors[0].iov_base = spans.first.data;
+    vectors[0].iov_len = spans.first.size;
+    vectors[1].iov_base = spans.second.data;
+    vectors[1].iov_len = spans.second.size;
+    return spans.second.size > 0 ? 2 : 1;
+}
+
+/**
+ * Fills @p vectors with the readable spans of the ring buffer, up to @p max
+ * bytes.
+ *
+ * @return
+ * The number of vectors used.
+ */
+int getReadableVectors(RingBuffer &ringBuffer, std::size_t max,
+                       iovec (&vectors)[2]) {
+    auto spans = ringBuffer.readableSpans();
+    auto first = std::min(max, spans.first.size);
+    auto second = std::min(max - first, spans.second.size);
+    vectors[0].iov_base = const_cast<char *>(spans.first.data);
+    vectors[0].iov_len = first;
+    vectors[1].iov_base = const_cast<char *>(spans.second.data);
+    vectors[1].iov_len = second;
+    return second > 0 ? 2 : 1;
+}
+
+} // namespace
+
+ssize_t hdc::ringbuffer::readFromFd(RingBuffer &ringBuffer, int fd,
+                                    std::size_t max) {
+    iovec vectors[2];
+    auto count = getWritableVectors(ringBuffer, max, vectors);
+    if (vectors[0].iov_len == 0) {
+        return 0;
+    }
+    auto result = readv(fd, vectors, count);
+    if (result > 0) {
+        ringBuffer.commitWrite(static_cast<std::size_t>(result));
+    }
+    return result;
+}
+
+ssize_t hdc::ringbuffer::writeToFd(RingBuffer &ringBuffer, int fd,
+                                   std::size_t max) {
+    iovec vectors[2];
+    auto count = getReadableVectors(ringBuffer, max, vectors);
+    if (vectors[0].iov_len == 0) {
+        return 0;
+    }
+    auto result = writev(fd, vectors, count);
+    if (result > 0) {
+        ringBuffer.consume(static_cast<std::size_t>(result));
+    }
+    return result;
+}
+
+ssize_t hdc::ringbuffer::receiveFromSocket(RingBuffer &ringBuffer, int fd,
+                                           std::size_t max, int flags) {
+    iovec vectors[2];
+    msghdr message = {};
+    message.msg_iov = vectors;
+    message.msg_iovlen = getWritableVectors(ringBuffer, max, vectors);
+    if (vectors[0].iov_len == 0) {
+        return 0;
+    }
+    auto result = recvmsg(fd, &message, flags);
+    if (result > 0) {
+        ringBuffer.commitWrite(static_cast<std::size_t>(result));
+    }
+    return result;
+}
+
+ssize_t hdc::ringbuffer::sendToSocket(RingBuffer &ringBuffer, int fd,
+                                      std::size_t max, int flags) {
+    iovec vectors[2];
+    msghdr message = {};
+    message.msg_iov = vectors;
+    message.msg_iovlen = getReadableVectors(ringBuffer, max, vectors);
+    if (vectors[0].iov_len == 0) {
+        return 0;
+    }
+    auto result = sendmsg(fd, &message, flags);
+    if (result > 0) {
+        ringBuffer.consume(static_cast<std::size_t>(result));
+    }
+    return result;
+}
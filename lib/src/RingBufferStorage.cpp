@@ -0,0 +1,370 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class RingBufferStorage.
+ */
+
+#include "RingBufferStorage.h"
+
+#include <limits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <cstdint>
+#include <sys/syscall.h>
+#include <vector>
+#endif
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+const std::size_t HUGE_PAGE_SIZE = std::size_t(1) << 21;
+const std::size_t GIGANTIC_PAGE_SIZE = std::size_t(1) << 30;
+
+/**
+ * Returns @p size rounded up to a multiple of @p unit, or 0 on overflow.
+ */
+std::size_t roundUp(std::size_t size, std::size_t unit) {
+    if (size > numeric_limits<std::size_t>::max() - (unit - 1)) {
+        return 0;
+    }
+    return (size + unit - 1) / unit * unit;
+}
+
+/**
+ * Returns the unit the memory's size is rounded up to.
+ */
+std::size_t getUnit(unsigned flags) {
+    if (flags & RingBufferStorage::GIGANTIC_PAGES) {
+        return GIGANTIC_PAGE_SIZE;
+    }
+    if (flags & RingBufferStorage::HUGE_PAGES) {
+        return HUGE_PAGE_SIZE;
+    }
+    return RingBufferStorage::getBasePageSize();
+}
+
+/**
+ * Writes to every page of the memory so that the page faults happen now.
+ */
+void prefault(char *buffer, std::size_t size, std::size_t pageSize) {
+    for (std::size_t offset = 0; offset < size; offset += pageSize) {
+        static_cast<volatile char *>(buffer)[offset] = 0;
+    }
+}
+
+#if defined(_WIN32)
+
+/**
+ * Allocates @p size bytes on @p node, or returns @c nullptr.
+ */
+char *allocate(std::size_t size, DWORD type, int node) {
+    auto preferred = node == RingBufferStorage::ANY_NODE
+                         ? NUMA_NO_PREFERRED_NODE
+                         : static_cast<DWORD>(node);
+    return static_cast<char *>(
+        VirtualAllocExNuma(GetCurrentProcess(), nullptr, size,
+                           MEM_RESERVE | MEM_COMMIT | type, PAGE_READWRITE,
+                           preferred));
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#if defined(__linux__)
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+// The memory policy constants from <numaif.h>, without linking libnuma.
+const int MPOL_BIND = 2;
+
+const int MASK_BITS = numeric_limits<unsigned long>::digits;
+
+/**
+ * Returns the node mask that holds only @p node.
+ */
+vector<unsigned long> getNodeMask(int node) {
+    vector<unsigned long> mask(static_cast<std::size_t>(node) / MASK_BITS + 1);
+    mask.back() = 1ul << (static_cast<std::size_t>(node) % MASK_BITS);
+    return mask;
+}
+
+/**
+ * Maps @p size bytes of @p pageSize huge pages from the huge page pool, taking
+ * them from @p node unless it is ANY_NODE, or returns @c nullptr.
+ */
+char *mapHugeTlb(std::size_t size, std::size_t pageSize, int node) {
+    const int shift = pageSize == GIGANTIC_PAGE_SIZE ? 30 : 21;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                      (shift << MAP_HUGE_SHIFT);
+    if (node == RingBufferStorage::ANY_NODE) {
+        auto buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return buffer == MAP_FAILED ? nullptr : static_cast<char *>(buffer);
+    }
+
+    // mmap() reserves the huge pages from the nodes the thread's memory
+    // policy allows, and binding the mapping afterwards does not move the
+    // reservation. Bind the thread around the call, so that a node without
+    // enough free huge pages fails here instead of raising SIGBUS when a page
+    // is first touched. The mask is large enough for any node the kernel
+    // supports.
+    int mode;
+    vector<unsigned long> saved(1024 / MASK_BITS);
+    if (syscall(SYS_get_mempolicy, &mode, saved.data(),
+                saved.size() * MASK_BITS, nullptr, 0u) != 0) {
+        return nullptr;
+    }
+    auto mask = getNodeMask(node);
+    // The kernel reads one bit less than the maximum node it is given.
+    if (syscall(SYS_set_mempolicy, MPOL_BIND, mask.data(),
+                mask.size() * MASK_BITS + 1) != 0) {
+        return nullptr;
+    }
+    auto buffer = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    // A failed restore leaves the thread bound to the node. Fail the
+    // allocation, so that the caller learns of it.
+    if (syscall(SYS_set_mempolicy, mode, saved.data(),
+                saved.size() * MASK_BITS + 1) != 0) {
+        if (buffer != MAP_FAILED) {
+            munmap(buffer, size);
+        }
+        return nullptr;
+    }
+    return buffer == MAP_FAILED ? nullptr : static_cast<char *>(buffer);
+}
+
+/**
+ * Binds the pages of the memory to @p node, before any of them is faulted
+ * in.
+ */
+bool bindToNode(char *buffer, std::size_t size, int node) {
+    auto mask = getNodeMask(node);
+    // The kernel reads one bit less than the maximum node it is given.
+    return syscall(SYS_mbind, buffer, size, MPOL_BIND, mask.data(),
+                   mask.size() * MASK_BITS + 1, 0u) == 0;
+}
+
+#endif
+
+/**
+ * Maps @p size bytes of base pages aligned to @p alignment, or returns
+ * @c nullptr.
+ *
+ * Maps more than needed and unmaps the misaligned head and the tail, so that
+ * the kernel can back the memory with transparent huge pages.
+ */
+char *mapAligned(std::size_t size, std::size_t alignment) {
+    auto extra = alignment - RingBufferStorage::getBasePageSize();
+    if (size > numeric_limits<std::size_t>::max() - extra) {
+        return nullptr;
+    }
+    auto mapping = mmap(nullptr, size + extra, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    auto start = static_cast<char *>(mapping);
+    auto address = reinterpret_cast<std::uintptr_t>(start);
+    auto head = (alignment - address % alignment) % alignment;
+    if (head != 0) {
+        munmap(start, head);
+    }
+    if (extra != head) {
+        munmap(start + head + size, extra - head);
+    }
+    return start + head;
+}
+
+#endif
+
+} // namespace
+
+#if defined(_WIN32)
+
+RingBufferStorage::RingBufferStorage(std::size_t minimumSize, unsigned flags,
+                                     int node)
+    : _buffer(nullptr), _size(0), _pageSize(0), _locked(false) {
+    auto size = roundUp(minimumSize, getUnit(flags));
+    if (size == 0 || node < ANY_NODE) {
+        return;
+    }
+    if (flags & (HUGE_PAGES | GIGANTIC_PAGES)) {
+        // Large pages are never paged out, so they count as locked.
+        auto large = GetLargePageMinimum();
+        if (large != 0 && size % large == 0) {
+            _buffer = allocate(size, MEM_LARGE_PAGES, node);
+            _pageSize = large;
+            _locked = _buffer != nullptr;
+        }
+    }
+    if (_buffer == nullptr) {
+        _buffer = allocate(size, 0, node);
+        _pageSize = getBasePageSize();
+    }
+    if (_buffer == nullptr) {
+        _pageSize = 0;
+        return;
+    }
+    _size = size;
+    if ((flags & LOCK) && !_locked) {
+        _locked = VirtualLock(_buffer, _size) != 0;
+    }
+    if ((flags & PREFAULT) && !_locked) {
+        prefault(_buffer, _size, _pageSize);
+    }
+}
+
+std::size_t RingBufferStorage::getBasePageSize() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+void RingBufferStorage::_unmap() {
+    if (_buffer != nullptr) {
+        VirtualFree(_buffer, 0, MEM_RELEASE);
+        _buffer = nullptr;
+        _size = 0;
+        _pageSize = 0;
+        _locked = false;
+    }
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+RingBufferStorage::RingBufferStorage(std::size_t minimumSize, unsigned flags,
+                                     int node)
+    : _buffer(nullptr), _size(0), _pageSize(0), _locked(false) {
+    auto size = roundUp(minimumSize, getUnit(flags));
+    if (size == 0 || node < ANY_NODE) {
+        return;
+    }
+#if defined(__linux__)
+    if (flags & GIGANTIC_PAGES) {
+        _buffer = mapHugeTlb(size, GIGANTIC_PAGE_SIZE, node);
+        _pageSize = GIGANTIC_PAGE_SIZE;
+    }
+    if (_buffer == nullptr && (flags & (HUGE_PAGES | GIGANTIC_PAGES))) {
+        _buffer = mapHugeTlb(size, HUGE_PAGE_SIZE, node);
+        _pageSize = HUGE_PAGE_SIZE;
+    }
+#endif
+    if (_buffer == nullptr) {
+        auto alignment = (flags & (HUGE_PAGES | GIGANTIC_PAGES))
+                             ? HUGE_PAGE_SIZE
+                             : getBasePageSize();
+        _buffer = mapAligned(size, alignment);
+        _pageSize = getBasePageSize();
+#if defined(__linux__)
+        if (_buffer != nullptr && (flags & (HUGE_PAGES | GIGANTIC_PAGES))) {
+            madvise(_buffer, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    if (_buffer == nullptr) {
+        _pageSize = 0;
+        return;
+    }
+    _size = size;
+#if defined(__linux__)
+    if (node != ANY_NODE && !bindToNode(_buffer, _size, node)) {
+        _unmap();
+        return;
+    }
+#endif
+    // Locking faults every page in, so only touch the pages if it fails.
+    if (flags & LOCK) {
+        _locked = mlock(_buffer, _size) == 0;
+    }
+    if ((flags & PREFAULT) && !_locked) {
+        prefault(_buffer, _size, _pageSize);
+    }
+}
+
+std::size_t RingBufferStorage::getBasePageSize() {
+    static const auto size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+void RingBufferStorage::_unmap() {
+    if (_buffer != nullptr) {
+        // Unmapping also unlocks the memory.
+        munmap(_buffer, _size);
+        _buffer = nullptr;
+        _size = 0;
+        _pageSize = 0;
+        _locked = false;
+    }
+}
+
+#else
+
+RingBufferStorage::RingBufferStorage(std::size_t, unsigned, int)
+    : _buffer(nullptr), _size(0), _pageSize(0), _locked(false) {}
+
+std::size_t RingBufferStorage::getBasePageSize() { return 4096; }
+
+void RingBufferStorage::_unmap() {}
+
+#endif
+
+RingBufferStorage::~RingBufferStorage() { _unmap(); }
+
+RingBufferStorage::RingBufferStorage(RingBufferStorage &&other) noexcept
+    : _buffer(other._buffer), _size(other._size), _pageSize(other._pageSize),
+      _locked(other._locked) {
+    other._buffer = nullptr;
+    other._size = 0;
+    other._pageSize = 0;
+    other._locked = false;
+}
+
+RingBufferStorage &
+RingBufferStorage::operator=(RingBufferStorage &&other) noexcept {
+    if (this != &other) {
+        _unmap();
+        _buffer = other._buffer;
+        _size = other._size;
+        _pageSize = other._pageSize;
+        _locked = other._locked;
+        other._buffer = nullptr;
+        other._size = 0;
+        other._pageSize = 0;
+        other._locked = false;
+    }
+    return *this;
+}
@@ -0,0 +1,290 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class RingBufferUring.
+ */
+
+#include "RingBufferUring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+// The largest transfer Linux performs in one read() or write().
+const std::size_t MAX_TRANSFER = 0x7ffff000;
+
+// Two entries for each of the read and the write.
+const unsigned ENTRIES = 4;
+
+// user_data is the part number, plus WRITE_TAG for writes.
+const std::uint64_t WRITE_TAG = 2;
+
+template <typename T> T *at(void *base, std::uint32_t offset) {
+    return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+}
+
+} // namespace
+
+RingBufferUring::RingBufferUring(RingBuffer &ringBuffer, void *buffer,
+                                 std::size_t size)
+    : _ringBuffer(ringBuffer), _buffer(static_cast<char *>(buffer)),
+      _size(size), _fd(-1), _rings(MAP_FAILED), _ringsSize(0),
+      _sqes(nullptr), _sqesSize(0), _sqHead(nullptr), _sqTail(nullptr),
+      _sqArray(nullptr), _sqMask(0), _sqEntries(0), _cqHead(nullptr),
+      _cqTail(nullptr), _cqes(nullptr), _cqMask(0), _unsubmitted(0),
+      _read(), _write() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    auto fd = static_cast<int>(syscall(__NR_io_uring_setup, ENTRIES, &params));
+    if (fd < 0) {
+        return;
+    }
+    _fd = fd;
+    // One mapping for both rings needs Linux 5.4.
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+        _teardown();
+        return;
+    }
+
+    _ringsSize = std::max<std::size_t>(
+        params.sq_off.array + params.sq_entries * sizeof(unsigned),
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    _rings = mmap(nullptr, _ringsSize, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_rings == MAP_FAILED) {
+        _teardown();
+        return;
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        _teardown();
+        return;
+    }
+    _sqes = static_cast<io_uring_sqe *>(sqes);
+
+    _sqHead = at<unsigned>(_rings, params.sq_off.head);
+    _sqTail = at<unsigned>(_rings, params.sq_off.tail);
+    _sqArray = at<unsigned>(_rings, params.sq_off.array);
+    _sqMask = *at<unsigned>(_rings, params.sq_off.ring_mask);
+    _sqEntries = params.sq_entries;
+    _cqHead = at<unsigned>(_rings, params.cq_off.head);
+    _cqTail = at<unsigned>(_rings, params.cq_off.tail);
+    _cqes = at<io_uring_cqe>(_rings, params.cq_off.cqes);
+    _cqMask = *at<unsigned>(_rings, params.cq_off.ring_mask);
+
+    // Pins the pages once, instead of for every operation.
+    iovec vector = {buffer, size};
+    if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, &vector,
+                1) != 0) {
+        _teardown();
+    }
+}
+
+RingBufferUring::~RingBufferUring() {
+    assert(!isReadPending() && !isWritePending());
+    _teardown();
+}
+
+bool RingBufferUring::prepareRead(int fd, std::size_t max) {
+    assert(isValid());
+    if (isReadPending()) {
+        return false;
+    }
+    return _prepare(_read, IORING_OP_READ_FIXED, fd,
+                    _ringBuffer.reserveWrite(max));
+}
+
+bool RingBufferUring::prepareWrite(int fd, std::size_t max) {
+    assert(isValid());
+    if (isWritePending()) {
+        return false;
+    }
+    auto readable = _ringBuffer.readableSpans();
+    auto first = std::min(max, readable.first.size);
+    auto second = std::min(max - first, readable.second.size);
+    SpanPair spans = {{const_cast<char *>(readable.first.data), first},
+                      {const_cast<char *>(readable.second.data), second}};
+    return _prepare(_write, IORING_OP_WRITE_FIXED, fd, spans);
+}
+
+int RingBufferUring::submit(bool wait) {
+    assert(isValid());
+    int completed = 0;
+    for (;;) {
+        unsigned flags = 0;
+        unsigned minimum = 0;
+        if (wait && (isReadPending() || isWritePending())) {
+            flags = IORING_ENTER_GETEVENTS;
+            minimum = 1;
+        }
+        if (_unsubmitted != 0 || minimum != 0) {
+            auto submitted = syscall(__NR_io_uring_enter, _fd, _unsubmitted,
+                                     minimum, flags, nullptr, 0);
+            if (submitted < 0) {
+                return -1;
+            }
+            _unsubmitted -= static_cast<unsigned>(submitted);
+        }
+
+        // The kernel publishes completions with a release store on the tail.
+        auto head = *_cqHead;
+        auto tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            auto &cqe = _cqes[head & _cqMask];
+            auto isWrite = (cqe.user_data & WRITE_TAG) != 0;
+            auto part = static_cast<unsigned>(cqe.user_data & 1);
+            if (_complete(isWrite ? _write : _read, part, cqe.res)) {
+                ++completed;
+            }
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+
+        // A wrapped operation completes in two entries, which may arrive
+        // separately.
+        if (!wait || completed != 0 || minimum == 0) {
+            return completed;
+        }
+    }
+}
+
+bool RingBufferUring::_prepare(_Operation &operation, unsigned opcode, int fd,
+                               const SpanPair &spans) {
+    if (spans.first.size == 0) {
+        return false;
+    }
+    auto first = std::min(spans.first.size, MAX_TRANSFER);
+    auto second = first == spans.first.size
+                      ? std::min(spans.second.size, MAX_TRANSFER - first)
+                      : 0;
+    auto parts = second != 0 ? 2u : 1u;
+    auto tail = *_sqTail;
+    if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) + parts >
+        _sqEntries) {
+        return false;
+    }
+
+    const Span ranges[] = {{spans.first.data, first},
+                           {spans.second.data, second}};
+    auto tag = opcode == IORING_OP_WRITE_FIXED ? WRITE_TAG : 0;
+    for (unsigned part = 0; part < parts; ++part) {
+        auto index = (tail + part) & _sqMask;
+        auto &sqe = _sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = static_cast<std::uint8_t>(opcode);
+        sqe.fd = fd;
+        // Offset -1 uses and updates the file position, as read() does, and
+        // is the only valid one for pipes and sockets.
+        sqe.off = static_cast<std::uint64_t>(-1);
+        sqe.addr = reinterpret_cast<std::uintptr_t>(ranges[part].data);
+        sqe.len = static_cast<std::uint32_t>(ranges[part].size);
+        sqe.buf_index = 0;
+        sqe.user_data = tag | part;
+        // A short first transfer cancels the second, so the two never leave
+        // a gap.
+        if (part + 1 < parts) {
+            sqe.flags = IOSQE_IO_LINK;
+        }
+        _sqArray[index] = index;
+    }
+    __atomic_store_n(_sqTail, tail + parts, __ATOMIC_RELEASE);
+    _unsubmitted += parts;
+
+    operation.parts = parts;
+    operation.start = spans.first.data;
+    operation.length = first;
+    operation.transferred = 0;
+    operation.result = 0;
+    return true;
+}
+
+bool RingBufferUring::_complete(_Operation &operation, unsigned part,
+                                int result) {
+    assert(operation.parts != 0);
+    if (result >= 0) {
+        operation.transferred += result;
+    } else if (operation.result == 0 && (part == 0 || result != -ECANCELED)) {
+        operation.result = result;
+    }
+    if (--operation.parts != 0) {
+        return false;
+    }
+
+    // Bytes that made it through take precedence over a later error, which
+    // the next operation reports again.
+    auto count = static_cast<std::size_t>(operation.transferred);
+    if (count != 0) {
+        operation.result = operation.transferred;
+    }
+    if (&operation == &_write) {
+        _ringBuffer.consume(count);
+    } else if (count != 0) {
+        auto free = _ringBuffer.reserveWrite(count);
+        if (free.first.data != operation.start) {
+            // The client code emptied the ring buffer while the read was in
+            // flight, which rewinds its write location to the beginning of
+            // the buffer. Move the bytes there.
+            assert(_ringBuffer.isEmpty());
+            if (count > operation.length) {
+                std::rotate(_buffer, operation.start,
+                            operation.start + operation.length);
+            } else {
+                std::memmove(free.first.data, operation.start, count);
+            }
+        }
+        _ringBuffer.commitWrite(count);
+    }
+    return true;
+}
+
+void RingBufferUring::_teardown() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqesSize);
+        _sqes = nullptr;
+    }
+    if (_rings != MAP_FAILED) {
+        munmap(_rings, _ringsSize);
+        _rings = MAP_FAILED;
+    }
+    if (_fd != -1) {
+        // Closing the instance also unregisters the buffer.
+        close(_fd);
+        _fd = -1;
+    }
+}
@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Implements class ShardedRingBuffer.
+ */
+
+#include "ShardedRingBuffer.h"
+
+#include <new>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+const std::size_t ShardedRingBuffer::HEADER_SIZE;
+
+ShardedRingBuffer::ShardedRingBuffer(void *arena, std::size_t size,
+                                     std::size_t shardCount)
+    : _shards(static_cast<SpscRingBuffer *>(arena)), _shardCount(shardCount),
+      _shardSize(0), _next(0) {
+    static_assert(sizeof(_Header) == HEADER_SIZE, "unexpected header size");
+    assert(arena != nullptr);
+    assert(reinterpret_cast<std::uintptr_t>(arena) % CACHE_LINE_SIZE == 0);
+    assert(shardCount > 0);
+    assert(size / shardCount > sizeof(SpscRingBuffer));
+
+    // The shard objects come first, then the shards themselves, each rounded
+    // down to whole cache lines so that neighbouring shards never share one.
+    _shardSize = (size / shardCount - sizeof(SpscRingBuffer)) /
+                 CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    assert(_shardSize > 0);
+    auto objects = static_cast<char *>(arena);
+    auto data = objects + shardCount * sizeof(SpscRingBuffer);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        new (objects + i * sizeof(SpscRingBuffer))
+            SpscRingBuffer(data + i * _shardSize, _shardSize);
+    }
+}
+
+ShardedRingBuffer::~ShardedRingBuffer() {
+    for (std::size_t i = 0; i < _shardCount; ++i) {
+        _shards[i].~SpscRingBuffer();
+    }
+}
+
+bool ShardedRingBuffer::isEmpty() const {
+    for (std::size_t i = 0; i < _shardCount; ++i) {
+        if (!_shards[i].isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ShardedRingBuffer::writeMessage(std::size_t shard, const void *message,
+                                     std::size_t size,
+                                     std::uint64_t sequence) {
+    assert(shard < _shardCount);
+    assert(message != nullptr || size == 0);
+
+    // Check for room first: the batch below would otherwise publish the
+    // header without the message.
+    auto &ring = _shards[shard];
+    if (size > _shardSize - HEADER_SIZE ||
+        ring.getWritableByteCount() < HEADER_SIZE + size) {
+        return false;
+    }
+
+    _Header header = {sequence, size};
+    const ConstSpan parts[] = {
+        {reinterpret_cast<const char *>(&header), sizeof(header)},
+        {static_cast<const char *>(message), size}};
+    auto count = size == 0 ? 1 : 2;
+    auto written = ring.writeBatch(parts, count);
+    assert(written == static_cast<std::size_t>(count));
+    (void)written;
+    return true;
+}
+
+bool ShardedRingBuffer::readMessage(void *destination, std::size_t capacity,
+                                    std::size_t &size, Order order) {
+    assert(destination != nullptr || capacity == 0);
+
+    _Header header;
+    auto shard = _pickShard(order, header);
+    if (shard == _shardCount) {
+        return false;
+    }
+    size = static_cast<std::size_t>(header.size);
+    if (size > capacity) {
+        return false;
+    }
+
+    const Span parts[] = {{reinterpret_cast<char *>(&header), sizeof(header)},
+                          {static_cast<char *>(destination), size}};
+    auto count = size == 0 ? 1 : 2;
+    auto read = _shards[shard].readBatch(parts, count);
+    assert(read == static_cast<std::size_t>(count));
+    (void)read;
+    _next = shard + 1 < _shardCount ? shard + 1 : 0;
+    return true;
+}
+
+std::size_t ShardedRingBuffer::_pickShard(Order order, _Header &header) {
+    // A producer publishes each header together with its message, so a shard
+    // that holds a header also holds the whole message.
+    auto best = _shardCount;
+    switch (order) {
+    case Order::ROUND_ROBIN:
+        for (std::size_t i = 0; i < _shardCount; ++i) {
+            auto shard = _next + i < _shardCount ? _next + i
+                                                 : _next + i - _shardCount;
+            if (_shards[shard].peekBytes(&header, sizeof(header)) ==
+                sizeof(header)) {
+                return shard;
+            }
+        }
+        break;
+
+    case Order::FULLEST: {
+        std::size_t most = 0;
+        for (std::size_t i = 0; i < _shardCount; ++i) {
+            auto readable = _shards[i].getReadableByteCount();
+            if (readable > most) {
+                best = i;
+                most = readable;
+            }
+        }
+        if (best != _shardCount) {
+            _shards[best].peekBytes(&header, sizeof(header));
+        }
+        break;
+    }
+
+    case Order::OLDEST:
+        for (std::size_t i = 0; i < _shardCount; ++i) {
+            _Header candidate;
+            if (_shards[i].peekBytes(&candidate, sizeof(candidate)) ==
+                    sizeof(candidate) &&
+                (best == _shardCount || candidate.sequence < header.sequence)) {
+                best = i;
+                header = candidate;
+            }
+        }
+        break;
+    }
+    return best;
+}
@@ -0,0 +1,216 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Implements class SharedMemory.
+ */
+
+#include "SharedMemory.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+#if defined(_WIN32)
+
+SharedMemory::SharedMemory(const char *name, std::size_t size)
+    : _buffer(nullptr), _size(0), _handle(nullptr) {
+    if (size == 0) {
+        return;
+    }
+    auto handle = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(static_cast<unsigned long long>(size) >> 32),
+        static_cast<DWORD>(size), name);
+    if (handle == nullptr) {
+        return;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(handle);
+        return;
+    }
+    _buffer = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (_buffer == nullptr) {
+        CloseHandle(handle);
+        return;
+    }
+    _size = size;
+    _handle = handle;
+}
+
+SharedMemory::SharedMemory(const char *name)
+    : _buffer(nullptr), _size(0), _handle(nullptr) {
+    auto handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    if (handle == nullptr) {
+        return;
+    }
+    _buffer = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (_buffer == nullptr ||
+        VirtualQuery(_buffer, &info, sizeof(info)) != sizeof(info)) {
+        if (_buffer != nullptr) {
+            UnmapViewOfFile(_buffer);
+            _buffer = nullptr;
+        }
+        CloseHandle(handle);
+        return;
+    }
+    _size = info.RegionSize;
+    _handle = handle;
+}
+
+bool SharedMemory::remove(const char *) { return true; }
+
+void SharedMemory::_unmap() {
+    if (_buffer != nullptr) {
+        UnmapViewOfFile(_buffer);
+        CloseHandle(_handle);
+        _buffer = nullptr;
+        _size = 0;
+        _handle = nullptr;
+    }
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+namespace {
+
+/**
+ * Maps @p size bytes of the shared memory object @p fd and closes @p fd.
+ */
+void *mapShared(int fd, std::size_t size) {
+    auto buffer =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the memory alive.
+    close(fd);
+    return buffer == MAP_FAILED ? nullptr : buffer;
+}
+
+} // namespace
+
+SharedMemory::SharedMemory(const char *name, std::size_t size)
+    : _buffer(nullptr), _size(0) {
+    if (size == 0) {
+        return;
+    }
+    auto fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd == -1) {
+        return;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return;
+    }
+    _buffer = mapShared(fd, size);
+    if (_buffer == nullptr) {
+        shm_unlink(name);
+        return;
+    }
+    _size = size;
+}
+
+SharedMemory::SharedMemory(const char *name) : _buffer(nullptr), _size(0) {
+    auto fd = shm_open(name, O_RDWR, 0);
+    if (fd == -1) {
+        return;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        close(fd);
+        return;
+    }
+    auto size = static_cast<std::size_t>(status.st_size);
+    _buffer = mapShared(fd, size);
+    if (_buffer != nullptr) {
+        _size = size;
+    }
+}
+
+bool SharedMemory::remove(const char *name) { return shm_unlink(name) == 0; }
+
+void SharedMemory::_unmap() {
+    if (_buffer != nullptr) {
+        munmap(_buffer, _size);
+        _buffer = nullptr;
+        _size = 0;
+    }
+}
+
+#else
+
+SharedMemory::SharedMemory(const char *, std::size_t)
+    : _buffer(nullptr), _size(0) {}
+
+SharedMemory::SharedMemory(const char *) : _buffer(nullptr), _size(0) {}
+
+bool SharedMemory::remove(const char *) { return false; }
+
+void SharedMemory::_unmap() {}
+
+#endif
+
+SharedMemory::~SharedMemory() { _unmap(); }
+
+SharedMemory::SharedMemory(SharedMemory &&other) noexcept
+    : _buffer(other._buffer), _size(other._size)
+#if defined(_WIN32)
+      ,
+      _handle(other._handle)
+#endif
+{
+    other._buffer = nullptr;
+    other._size = 0;
+#if defined(_WIN32)
+    other._handle = nullptr;
+#endif
+}
+
+SharedMemory &SharedMemory::operator=(SharedMemory &&other) noexcept {
+    if (this != &other) {
+        _unmap();
+        _buffer = other._buffer;
+        _size = other._size;
+        other._buffer = nullptr;
+        other._size = 0;
+#if defined(_WIN32)
+        _handle = other._handle;
+        other._handle = nullptr;
+#endif
+    }
+    return *this;
+}
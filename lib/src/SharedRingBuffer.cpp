@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file
+ * Implements class SharedRingBuffer.
+ */
+
+#include "SharedRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+// The control block is shared between processes, so the atomics in it must
+// not rely on a process-local lock.
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+              "SharedRingBuffer needs lock-free 32-bit and 64-bit atomics");
+
+void SharedRingBuffer::initialize(void *memory, std::size_t size) {
+    assert(memory != nullptr);
+    assert(reinterpret_cast<std::uintptr_t>(memory) % alignof(_Control) == 0);
+    assert(size > sizeof(_Control));
+
+    auto control = new (memory) _Control;
+    control->version = VERSION;
+    control->controlSize = sizeof(_Control);
+    control->reserved = 0;
+    control->capacity = size - sizeof(_Control);
+    control->write.store(0, memory_order_relaxed);
+    control->read.store(0, memory_order_relaxed);
+    // Publish the magic number last, so that a process that sees it also
+    // sees the rest of the control block.
+    control->magic.store(MAGIC, memory_order_release);
+}
+
+SharedRingBuffer::SharedRingBuffer(void *memory, std::size_t size)
+    : _control(nullptr), _buffer(nullptr), _size(0), _cachedRead(0),
+      _cachedWrite(0) {
+    if (memory == nullptr ||
+        reinterpret_cast<std::uintptr_t>(memory) % alignof(_Control) != 0 ||
+        size <= sizeof(_Control)) {
+        return;
+    }
+    // The control block was constructed by initialize(), possibly in another
+    // process.
+    auto control = static_cast<_Control *>(memory);
+    if (control->magic.load(memory_order_acquire) != MAGIC ||
+        control->version != VERSION ||
+        control->controlSize != sizeof(_Control) || control->capacity == 0 ||
+        control->capacity > size - sizeof(_Control) ||
+        control->capacity > numeric_limits<std::size_t>::max() / 2) {
+        return;
+    }
+    auto capacity = static_cast<std::size_t>(control->capacity);
+    auto read = control->read.load(memory_order_acquire);
+    auto write = control->write.load(memory_order_acquire);
+    if (read >= 2 * capacity || write >= 2 * capacity) {
+        return;
+    }
+
+    _control = control;
+    _buffer = static_cast<char *>(memory) + sizeof(_Control);
+    _size = capacity;
+    _cachedRead = read;
+    _cachedWrite = write;
+}
+
+std::size_t SharedRingBuffer::writeBytes(const void *source,
+                                         std::size_t count) {
+    _assertValid();
+
+    assert(source != nullptr);
+
+    auto write = _control->write.load(memory_order_relaxed);
+    auto writable = _size - _distance(_cachedRead, write);
+    if (writable < count) {
+        _cachedRead = _control->read.load(memory_order_acquire);
+        writable = _size - _distance(_cachedRead, write);
+    }
+    count = std::min(count, writable);
+    if (count == 0) {
+        return 0;
+    }
+
+    // Write up to end of buffer, then wrap around to beginning of buffer.
+    auto offset = static_cast<std::size_t>(write < _size ? write
+                                                         : write - _size);
+    auto n = std::min(count, _size - offset);
+    std::memcpy(_buffer + offset, source, n);
+    std::memcpy(_buffer, static_cast<const char *>(source) + n, count - n);
+
+    _control->write.store(_advance(write, count), memory_order_release);
+    return count;
+}
+
+std::size_t SharedRingBuffer::_readBytes(void *destination, std::size_t count,
+                                         bool consume) {
+    _assertValid();
+
+    auto read = _control->read.load(memory_order_relaxed);
+    auto readable = _distance(read, _cachedWrite);
+    if (readable < count) {
+        _cachedWrite = _control->write.load(memory_order_acquire);
+        readable = _distance(read, _cachedWrite);
+    }
+    count = std::min(count, readable);
+    if (count == 0) {
+        return 0;
+    }
+
+    if (destination != nullptr) {
+        // Read up to end of buffer, then wrap around to beginning of buffer.
+        auto offset =
+            static_cast<std::size_t>(read < _size ? read : read - _size);
+        auto n = std::min(count, _size - offset);
+        std::memcpy(destination, _buffer + offset, n);
+        std::memcpy(static_cast<char *>(destination) + n, _buffer, count - n);
+    }
+
+    if (consume) {
+        _control->read.store(_advance(read, count), memory_order_release);
+    }
+    return count;
+}
+
+void SharedRingBuffer::_assertValid() const {
+    assert(_control != nullptr);
+    assert(_size > 0);
+}
@@ -0,0 +1,442 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements class SpscRingBuffer.
+ */
+
+#include "SpscRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) ||           \
+    defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+const unsigned MIN_SPIN = 16;
+const unsigned MAX_SPIN = 16 * 1024;
+
+/**
+ * Tells the processor that the calling thread is spinning.
+ */
+void cpuRelax() {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) ||           \
+    defined(_M_X64)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * Sleeps while @p word holds @p value, for at most @p timeout. May return
+ * early.
+ */
+void park(std::atomic<std::uint32_t> &word, std::uint32_t value,
+          std::chrono::nanoseconds timeout) {
+#if defined(__linux__)
+    static_assert(sizeof(word) == sizeof(std::uint32_t),
+                  "futex word must be a plain 32-bit integer");
+    struct timespec relative;
+    relative.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    relative.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+            FUTEX_WAIT_PRIVATE, value, &relative, nullptr, 0);
+#elif defined(_WIN32)
+    auto milliseconds =
+        std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+    WaitOnAddress(&word, &value, sizeof(value),
+                  static_cast<DWORD>(std::min<long long>(
+                      milliseconds + 1, static_cast<long long>(INFINITE - 1))));
+#else
+    // No address-based wait: sleep in short slices instead.
+    (void)word;
+    (void)value;
+    std::this_thread::sleep_for(
+        std::min(timeout, std::chrono::nanoseconds(100000)));
+#endif
+}
+
+/**
+ * Tries to enable heavyFence().
+ */
+bool registerHeavyFence() {
+#if defined(__linux__)
+    return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0,
+                   0) == 0;
+#elif defined(_WIN32)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Issues a full memory barrier on every running thread of the process, so
+ * that the other threads only need a compiler barrier to pair with it.
+ */
+void heavyFence() {
+#if defined(__linux__)
+    syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+#elif defined(_WIN32)
+    FlushProcessWriteBuffers();
+#endif
+}
+
+/**
+ * Wakes the threads sleeping on @p word.
+ */
+void unpark(std::atomic<std::uint32_t> &word) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word),
+            FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll(&word);
+#else
+    (void)word;
+#endif
+}
+
+} // namespace
+
+/**
+ * @class hdc::ringbuffer::SpscRingBuffer
+ *
+ * @internal
+ *
+ * # Internal Details
+ *
+ * Unlike RingBuffer, this class cannot use sentinel values to tell the empty
+ * and full states apart, since the producer and the consumer each own one
+ * index and neither can update the other's. Instead, @c _read and @c _write
+ * count bytes modulo <tt>2 * _size</tt>. A byte counted by index @c i lives at
+ * offset <tt>i % _size</tt> in the buffer. The number of readable bytes is the
+ * distance from @c _read to @c _write, which is always in the range
+ * <tt>[0, _size]</tt>, so the two indices are equal only when the buffer is
+ * empty and are @c _size apart only when the buffer is full.
+ *
+ * The producer loads @c _read with acquire semantics, so that it does not
+ * overwrite bytes the consumer is still reading, and stores @c _write with
+ * release semantics, so that the consumer sees the bytes before it sees the
+ * new index. The consumer does the mirror image. Neither side ever waits for
+ * the other, except in readBytesWait() and writeBytesWait().
+ *
+ * The producer-owned members (@c _write and @c _cachedRead) and the
+ * consumer-owned members (@c _read and @c _cachedWrite) sit on separate cache
+ * lines, so that one side's updates do not invalidate the line the other side
+ * is working on. Each side also keeps a private copy of the other side's
+ * index and only reloads the shared one when its copy says the buffer is full
+ * (for the producer) or empty (for the consumer). As long as they are not
+ * fighting over the last few bytes, each side therefore touches the other
+ * side's cache line once per lap rather than once per call.
+ *
+ * A thread that waits first polls for a while, pausing between polls. Each
+ * side adapts how long it polls: it doubles the spin when polling succeeds
+ * and halves it when it has to sleep. To sleep, the consumer sets
+ * @c _readWaiting, issues a full fence and checks the ring buffer once more
+ * before parking on the flag (a futex on Linux). After publishing a new index,
+ * the producer fences and wakes the consumer only if the flag is set, so it
+ * makes no system call unless the consumer is actually asleep. The producer
+ * waits on @c _writeWaiting in the same way. The two fences ensure that
+ * either the sleeper sees the new index or the waker sees the flag.
+ *
+ * A full fence on every index update would double the cost of small
+ * transfers, so where the platform allows it (membarrier() on Linux,
+ * FlushProcessWriteBuffers() on Windows) the fences are asymmetric: the
+ * thread about to sleep issues a barrier on every thread of the process, and
+ * the waker gets away with a compiler barrier. The flags sit on a cache line
+ * of their own, which stays shared and clean unless a thread goes to sleep.
+ */
+
+std::size_t SpscRingBuffer::writeBytes(const void *source, std::size_t count) {
+    _assertValid();
+
+    assert(source != nullptr);
+
+    auto write = _write.load(memory_order_relaxed);
+    auto writable = _size - _distance(_cachedRead, write);
+    if (writable < count) {
+        _cachedRead = _read.load(memory_order_acquire);
+        writable = _size - _distance(_cachedRead, write);
+    }
+    auto isShort = writable < count;
+    count = std::min(count, writable);
+    _countWrite(write, count, isShort, writable - count);
+    if (count == 0) {
+        return 0;
+    }
+
+    // Write up to end of buffer, then wrap around to beginning of buffer.
+    auto offset = write < _size ? write : write - _size;
+    auto n = std::min(count, _size - offset);
+    _copy(_buffer + offset, source, n);
+    if (n != count) {
+        _copy(_buffer, static_cast<const char *>(source) + n, count - n);
+    }
+
+    _write.store(_advance(write, count), memory_order_release);
+    _signal(_readWaiting);
+    return count;
+}
+
+std::size_t SpscRingBuffer::writeBytesWait(const void *source,
+                                           std::size_t count,
+                                           std::chrono::nanoseconds timeout) {
+    assert(source != nullptr);
+    _wait(std::min(count, _size), false, timeout);
+    return writeBytes(source, count);
+}
+
+std::size_t SpscRingBuffer::readBytesWait(void *destination,
+                                          std::size_t count,
+                                          std::chrono::nanoseconds timeout) {
+    assert(destination != nullptr);
+    _wait(std::min(count, _size), true, timeout);
+    return readBytes(destination, count);
+}
+
+std::size_t SpscRingBuffer::writeBatch(const ConstSpan *messages,
+                                      std::size_t count) {
+    _assertValid();
+
+    assert(messages != nullptr || count == 0);
+
+    // Refresh the consumer's index once, since the batch is likely to need
+    // more space than the cached copy promises.
+    auto write = _write.load(memory_order_relaxed);
+    _cachedRead = _read.load(memory_order_acquire);
+    auto writable = _size - _distance(_cachedRead, write);
+
+    auto offset = write < _size ? write : write - _size;
+    std::size_t written = 0;
+    std::size_t i = 0;
+    for (; i < count && messages[i].size <= writable - written; ++i) {
+        assert(messages[i].data != nullptr);
+        // Write up to end of buffer, then wrap around to beginning of buffer.
+        auto n = std::min(messages[i].size, _size - offset);
+        std::memcpy(_buffer + offset, messages[i].data, n);
+        if (n < messages[i].size) {
+            std::memcpy(_buffer, messages[i].data + n, messages[i].size - n);
+        }
+        offset = offset + messages[i].size < _size
+                     ? offset + messages[i].size
+                     : offset + messages[i].size - _size;
+        written += messages[i].size;
+    }
+
+    if (written != 0) {
+        _write.store(_advance(write, written), memory_order_release);
+        _signal(_readWaiting);
+    }
+    _countWrite(write, written, i < count, writable - written);
+    return i;
+}
+
+std::size_t SpscRingBuffer::readBatch(const Span *messages,
+                                     std::size_t count) {
+    _assertValid();
+
+    assert(messages != nullptr || count == 0);
+
+    // Refresh the producer's index once, since the batch is likely to need
+    // more bytes than the cached copy promises.
+    auto read = _read.load(memory_order_relaxed);
+    _cachedWrite = _write.load(memory_order_acquire);
+    auto readable = _distance(read, _cachedWrite);
+
+    auto offset = read < _size ? read : read - _size;
+    std::size_t consumed = 0;
+    std::size_t i = 0;
+    for (; i < count && messages[i].size <= readable - consumed; ++i) {
+        assert(messages[i].data != nullptr);
+        // Read up to end of buffer, then wrap around to beginning of buffer.
+        auto n = std::min(messages[i].size, _size - offset);
+        std::memcpy(messages[i].data, _buffer + offset, n);
+        if (n < messages[i].size) {
+            std::memcpy(messages[i].data + n, _buffer, messages[i].size - n);
+        }
+        offset = offset + messages[i].size < _size
+                     ? offset + messages[i].size
+                     : offset + messages[i].size - _size;
+        consumed += messages[i].size;
+    }
+
+    if (consumed != 0) {
+        _read.store(_advance(read, consumed), memory_order_release);
+        _signal(_writeWaiting);
+    }
+    _countRead(consumed, i < count, readable - consumed);
+    return i;
+}
+
+std::size_t SpscRingBuffer::_readBytes(void *destination, std::size_t count,
+                                       std::size_t where, bool consume) {
+    _assertValid();
+
+    assert(where == 0 || !consume);
+
+    auto read = _read.load(memory_order_relaxed);
+    auto readable = _distance(read, _cachedWrite);
+    if (readable < where || readable - where < count) {
+        _cachedWrite = _write.load(memory_order_acquire);
+        readable = _distance(read, _cachedWrite);
+    }
+    auto available = where < readable ? readable - where : 0;
+    auto isShort = available < count;
+    count = std::min(count, available);
+    if (consume) {
+        _countRead(count, isShort, readable - count);
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    if (destination != nullptr) {
+        // Read up to end of buffer, then wrap around to beginning of buffer.
+        auto index = _advance(read, where);
+        auto offset = index < _size ? index : index - _size;
+        auto n = std::min(count, _size - offset);
+        _copy(destination, _buffer + offset, n);
+        if (n != count) {
+            _copy(static_cast<char *>(destination) + n, _buffer, count - n);
+        }
+    }
+
+    if (consume) {
+        _read.store(_advance(read, count), memory_order_release);
+        _signal(_writeWaiting);
+    }
+    return count;
+}
+
+void SpscRingBuffer::_wait(std::size_t count, bool readable,
+                           std::chrono::nanoseconds timeout) {
+    assert(count <= _size);
+
+    auto ready = [this, count, readable] {
+        return (readable ? getReadableByteCount() : getWritableByteCount()) >=
+               count;
+    };
+    if (ready()) {
+        return;
+    }
+
+    // Poll for a while: the other side is likely to be running already.
+    auto &spin = readable ? _readSpin : _writeSpin;
+    for (unsigned i = 0; i < spin; ++i) {
+        cpuRelax();
+        if (ready()) {
+            spin = std::min(spin * 2, MAX_SPIN);
+            return;
+        }
+    }
+    spin = std::max(spin / 2, MIN_SPIN);
+
+    // Sleep until the other side signals or the timeout expires.
+    auto &waiting = readable ? _readWaiting : _writeWaiting;
+    // Clamp the timeout, so that nanoseconds::max() waits forever instead of
+    // overflowing the deadline.
+    auto now = chrono::steady_clock::now();
+    auto limit = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::time_point::max() - now);
+    auto deadline =
+        now + chrono::duration_cast<chrono::steady_clock::duration>(
+                  std::min(timeout, limit));
+    for (;;) {
+        waiting.store(1, memory_order_relaxed);
+        // Pairs with the fence in _signal().
+        if (_asymmetricFences) {
+            heavyFence();
+        } else {
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+        if (ready()) {
+            break;
+        }
+        auto remaining = deadline - chrono::steady_clock::now();
+        if (remaining <= chrono::steady_clock::duration::zero()) {
+            break;
+        }
+        park(waiting, 1,
+             chrono::duration_cast<chrono::nanoseconds>(remaining));
+    }
+    waiting.store(0, memory_order_relaxed);
+}
+
+void SpscRingBuffer::_wake(std::atomic<std::uint32_t> &waiting) {
+    waiting.store(0, memory_order_relaxed);
+    unpark(waiting);
+}
+
+bool SpscRingBuffer::_haveAsymmetricFences() {
+    static const bool registered = registerHeavyFence();
+    return registered;
+}
+
+const unsigned SpscRingBuffer::INITIAL_SPIN;
+
+RingBufferStats SpscRingBuffer::getStats() const {
+    RingBufferStats stats = {};
+#if defined(HDC_RINGBUFFER_STATS)
+    stats.bytesWritten = _bytesWritten.load(memory_order_relaxed);
+    stats.bytesRead = _bytesRead.load(memory_order_relaxed);
+    stats.shortWrites = _shortWrites.load(memory_order_relaxed);
+    stats.shortReads = _shortReads.load(memory_order_relaxed);
+    stats.fullCount = _fullCount.load(memory_order_relaxed);
+    stats.emptyCount = _emptyCount.load(memory_order_relaxed);
+    stats.wrapCount = _wrapCount.load(memory_order_relaxed);
+    stats.peakReadableBytes = _peakReadableBytes.load(memory_order_relaxed);
+#endif
+    return stats;
+}
+
+void SpscRingBuffer::_assertValid() const {
+    assert(_buffer != nullptr);
+    assert(_size > 0);
+    assert(_size <= numeric_limits<std::size_t>::max() / 2);
+}
@@ -0,0 +1,196 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "AsyncRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Coroutine that starts right away and cleans up after itself.
+ */
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+Task produce(AsyncRingBuffer &ring, const vector<char> &data, size_t chunk,
+             size_t &written, bool &done) {
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        auto count = min(chunk, data.size() - i);
+        written += co_await ring.writeAsync(data.data() + i, count);
+    }
+    done = true;
+}
+
+Task consume(AsyncRingBuffer &ring, vector<char> &data, size_t count,
+             size_t chunk, size_t &resumes, bool &done) {
+    while (data.size() < count) {
+        auto wanted = min(chunk, count - data.size());
+        auto readable = co_await ring.readAtLeast(wanted);
+        EXPECT_GE(readable, wanted);
+        ++resumes;
+        auto size = data.size();
+        data.resize(size + readable);
+        ring.readBytes(data.data() + size, readable);
+    }
+    done = true;
+}
+
+} // namespace
+
+TEST(AsyncRingBufferTest, WriteCompletesWithoutWaitingIfItFits) {
+    char buffer[16];
+    RingBuffer ring(buffer, sizeof(buffer));
+    AsyncScheduler scheduler;
+    AsyncRingBuffer async_ring(ring, scheduler);
+
+    vector<char> data(16, 'x');
+    size_t written = 0;
+    bool done = false;
+    produce(async_ring, data, 16, written, done);
+    ASSERT_TRUE(done);
+    ASSERT_EQ(written, 16u);
+    ASSERT_TRUE(ring.isFull());
+    ASSERT_FALSE(scheduler.hasReady());
+}
+
+TEST(AsyncRingBufferTest, ProducerResumesOnceAllBytesAreWritten) {
+    char buffer[8];
+    RingBuffer ring(buffer, sizeof(buffer));
+    AsyncScheduler scheduler;
+    AsyncRingBuffer async_ring(ring, scheduler);
+
+    vector<char> data(20);
+    iota(data.begin(), data.end(), 0);
+    size_t written = 0;
+    bool done = false;
+    produce(async_ring, data, 20, written, done);
+    ASSERT_FALSE(done);
+    ASSERT_TRUE(ring.isFull());
+
+    // Each read makes room that the waiting producer fills right away, but
+    // the producer resumes only once the last byte is in.
+    char read_buffer[20];
+    ASSERT_EQ(async_ring.readBytes(read_buffer, 5), 5u);
+    ASSERT_TRUE(ring.isFull());
+    ASSERT_FALSE(scheduler.hasReady());
+    ASSERT_EQ(async_ring.readBytes(read_buffer + 5, 5), 5u);
+    ASSERT_FALSE(scheduler.hasReady());
+    ASSERT_EQ(async_ring.readBytes(read_buffer + 10, 5), 5u);
+    ASSERT_TRUE(scheduler.hasReady());
+    ASSERT_FALSE(done);
+
+    ASSERT_EQ(scheduler.runReady(), 1u);
+    ASSERT_TRUE(done);
+    ASSERT_EQ(written, 20u);
+    ASSERT_EQ(async_ring.readBytes(read_buffer + 15, 5), 5u);
+    ASSERT_TRUE(equal(data.begin(), data.end(), read_buffer));
+}
+
+TEST(AsyncRingBufferTest, ConsumerResumesOnceEnoughBytesArrive) {
+    char buffer[16];
+    RingBuffer ring(buffer, sizeof(buffer));
+    AsyncScheduler scheduler;
+    AsyncRingBuffer async_ring(ring, scheduler);
+
+    vector<char> data;
+    size_t resumes = 0;
+    bool done = false;
+    consume(async_ring, data, 5, 5, resumes, done);
+    ASSERT_EQ(resumes, 0u);
+
+    for (char c = 'a'; c < 'e'; ++c) {
+        ASSERT_EQ(async_ring.writeBytes(&c, 1), 1u);
+        ASSERT_FALSE(scheduler.hasReady());
+    }
+    auto spans = ring.readableSpans();
+    ASSERT_EQ(spans.first.size, 4u);
+
+    char *free_data = ring.reserveWrite(1).first.data;
+    *free_data = 'e';
+    async_ring.commitWrite(1);
+    ASSERT_EQ(scheduler.runReady(), 1u);
+    ASSERT_EQ(resumes, 1u);
+    ASSERT_TRUE(done);
+    ASSERT_EQ(string(data.begin(), data.end()), "abcde");
+}
+
+TEST(AsyncRingBufferTest, OneLoopDrivesManyRings) {
+    const size_t rings = 100;
+    const size_t size = 64;
+    const size_t count = 5000;
+    AsyncScheduler scheduler;
+    vector<char> data(count);
+    iota(data.begin(), data.end(), 0);
+
+    vector<vector<char>> buffers(rings, vector<char>(size));
+    vector<unique_ptr<RingBuffer>> ring_buffers;
+    vector<unique_ptr<AsyncRingBuffer>> async_rings;
+    vector<vector<char>> received(rings);
+    vector<size_t> written(rings);
+    vector<size_t> resumes(rings);
+    unique_ptr<bool[]> produced(new bool[rings]());
+    unique_ptr<bool[]> consumed(new bool[rings]());
+    for (size_t i = 0; i < rings; ++i) {
+        ring_buffers.emplace_back(new RingBuffer(buffers[i].data(), size));
+        async_rings.emplace_back(
+            new AsyncRingBuffer(*ring_buffers[i], scheduler));
+        consume(*async_rings[i], received[i], count, 16, resumes[i],
+                consumed[i]);
+        produce(*async_rings[i], data, 100, written[i], produced[i]);
+    }
+
+    size_t batches = 0;
+    while (scheduler.hasReady()) {
+        scheduler.runReady();
+        ++batches;
+    }
+    ASSERT_GT(batches, 0u);
+    for (size_t i = 0; i < rings; ++i) {
+        ASSERT_TRUE(produced[i]);
+        ASSERT_TRUE(consumed[i]);
+        ASSERT_EQ(written[i], count);
+        ASSERT_EQ(received[i], data);
+        // The consumer reads everything readable at each resume, so it takes
+        // far fewer resumes than 16-byte chunks.
+        ASSERT_LT(resumes[i], count / 16);
+    }
+}
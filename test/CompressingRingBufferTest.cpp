@@ -0,0 +1,204 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "CompressingRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Run-length codec: each run is a count byte followed by the repeated byte.
+ */
+class RunLengthCodec : public Codec {
+public:
+    size_t compressions = 0;
+
+    size_t getMaxCompressedSize(size_t size) const override {
+        return 2 * size;
+    }
+
+    size_t compress(void *destination, size_t capacity, const void *source,
+                    size_t size) override {
+        ++compressions;
+        auto out = static_cast<uint8_t *>(destination);
+        auto in = static_cast<const uint8_t *>(source);
+        size_t written = 0;
+        for (size_t i = 0; i < size;) {
+            size_t run = 1;
+            while (i + run < size && run < 255 && in[i + run] == in[i]) {
+                ++run;
+            }
+            if (written + 2 > capacity) {
+                return 0;
+            }
+            out[written++] = static_cast<uint8_t>(run);
+            out[written++] = in[i];
+            i += run;
+        }
+        return written;
+    }
+
+    size_t decompress(void *destination, size_t capacity, const void *source,
+                      size_t size) override {
+        auto out = static_cast<uint8_t *>(destination);
+        auto in = static_cast<const uint8_t *>(source);
+        size_t written = 0;
+        for (size_t i = 0; i + 1 < size; i += 2) {
+            for (size_t j = 0; j < in[i] && written < capacity; ++j) {
+                out[written++] = in[i + 1];
+            }
+        }
+        return written;
+    }
+};
+
+} // namespace
+
+class CompressingRingBufferTest : public testing::Test {
+protected:
+    CompressingRingBufferTest()
+        : m_buffer(BUFFER_SIZE), m_ring_buffer(m_buffer.data(), BUFFER_SIZE),
+          m_compressing(m_ring_buffer, m_codec, BLOCK_SIZE) {}
+
+    static const size_t BUFFER_SIZE = 256;
+    static const size_t BLOCK_SIZE = 64;
+
+    vector<char> m_buffer;
+    RingBuffer m_ring_buffer;
+    RunLengthCodec m_codec;
+    CompressingRingBuffer m_compressing;
+};
+
+const size_t CompressingRingBufferTest::BUFFER_SIZE;
+const size_t CompressingRingBufferTest::BLOCK_SIZE;
+
+TEST_F(CompressingRingBufferTest, CompressesWholeBlocks) {
+    vector<char> data(4 * BLOCK_SIZE, 'a');
+    ASSERT_EQ(m_compressing.writeBytes(data.data(), data.size()), data.size());
+    ASSERT_EQ(m_codec.compressions, 4u);
+    ASSERT_EQ(m_compressing.getPendingByteCount(), 0u);
+    ASSERT_EQ(m_compressing.getReadableByteCount(), data.size());
+    // Each block of 64 'a's is one run.
+    ASSERT_EQ(m_compressing.getCompressedByteCount(),
+              4 * (CompressingRingBuffer::HEADER_SIZE + 2));
+
+    vector<char> read_buffer(data.size());
+    ASSERT_EQ(m_compressing.readBytes(read_buffer.data(), read_buffer.size()),
+              data.size());
+    ASSERT_EQ(read_buffer, data);
+    ASSERT_TRUE(m_compressing.isEmpty());
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST_F(CompressingRingBufferTest, GathersPartialBlocksUntilFlush) {
+    const char text[] = "aaaabbbb";
+    ASSERT_EQ(m_compressing.writeBytes(text, 8), 8u);
+    ASSERT_EQ(m_compressing.getPendingByteCount(), 8u);
+    ASSERT_TRUE(m_compressing.isEmpty());
+    ASSERT_EQ(m_codec.compressions, 0u);
+
+    ASSERT_TRUE(m_compressing.flush());
+    ASSERT_TRUE(m_compressing.flush());
+    ASSERT_EQ(m_codec.compressions, 1u);
+    ASSERT_EQ(m_compressing.getReadableByteCount(), 8u);
+    ASSERT_EQ(m_compressing.getCompressedByteCount(),
+              CompressingRingBuffer::HEADER_SIZE + 4);
+
+    // Reads smaller than a block are served from the decoded block.
+    char read_buffer[8];
+    ASSERT_EQ(m_compressing.readBytes(read_buffer, 3), 3u);
+    ASSERT_EQ(m_compressing.getReadableByteCount(), 5u);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+    ASSERT_EQ(m_compressing.readBytes(read_buffer + 3, 8), 5u);
+    ASSERT_EQ(string(read_buffer, 8), "aaaabbbb");
+}
+
+TEST_F(CompressingRingBufferTest, StoresIncompressibleBlocksRaw) {
+    vector<char> data(BLOCK_SIZE);
+    iota(data.begin(), data.end(), 0);
+    ASSERT_EQ(m_compressing.writeBytes(data.data(), data.size()), data.size());
+    ASSERT_EQ(m_compressing.getCompressedByteCount(),
+              CompressingRingBuffer::HEADER_SIZE + BLOCK_SIZE);
+
+    vector<char> read_buffer(BLOCK_SIZE);
+    ASSERT_EQ(m_compressing.readBytes(read_buffer.data(), BLOCK_SIZE),
+              BLOCK_SIZE);
+    ASSERT_EQ(read_buffer, data);
+}
+
+TEST_F(CompressingRingBufferTest, StopsWhenRingBufferIsFull) {
+    vector<char> data(BLOCK_SIZE);
+    iota(data.begin(), data.end(), 0);
+    // Raw blocks take 72 bytes, so three fit and a fourth gathers.
+    for (size_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(m_compressing.writeBytes(data.data(), data.size()),
+                  data.size());
+    }
+    ASSERT_EQ(m_compressing.getPendingByteCount(), BLOCK_SIZE);
+    ASSERT_EQ(m_compressing.writeBytes(data.data(), 1), 0u);
+    ASSERT_FALSE(m_compressing.flush());
+    ASSERT_EQ(m_compressing.getReadableByteCount(), 3 * BLOCK_SIZE);
+
+    vector<char> read_buffer(BLOCK_SIZE);
+    ASSERT_EQ(m_compressing.readBytes(read_buffer.data(), BLOCK_SIZE),
+              BLOCK_SIZE);
+    ASSERT_EQ(m_compressing.writeBytes(data.data(), 1), 1u);
+    ASSERT_EQ(m_compressing.getReadableByteCount(), 3 * BLOCK_SIZE);
+
+    m_compressing.clear();
+    ASSERT_TRUE(m_compressing.isEmpty());
+    ASSERT_EQ(m_compressing.getPendingByteCount(), 0u);
+    ASSERT_EQ(m_compressing.getCompressedByteCount(), 0u);
+}
+
+TEST_F(CompressingRingBufferTest, RoundTripsAcrossTheWrap) {
+    // Runs of varying length, so that block sizes vary and blocks and headers
+    // land across the end of the ring buffer.
+    vector<char> data;
+    for (size_t i = 0; data.size() < 20000; ++i) {
+        data.insert(data.end(), i % 37 + 1, static_cast<char>(i));
+    }
+    vector<char> read_buffer;
+    vector<char> chunk(BLOCK_SIZE + 13);
+    size_t written = 0;
+    while (read_buffer.size() < data.size()) {
+        written += m_compressing.writeBytes(
+            data.data() + written, min<size_t>(50, data.size() - written));
+        if (written == data.size()) {
+            ASSERT_TRUE(m_compressing.flush());
+        }
+        auto read = m_compressing.readBytes(chunk.data(), chunk.size());
+        read_buffer.insert(read_buffer.end(), chunk.begin(),
+                           chunk.begin() + read);
+    }
+    ASSERT_EQ(read_buffer, data);
+}
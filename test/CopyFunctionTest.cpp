@@ -0,0 +1,64 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "CopyFunction.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+TEST(CopyFunctionTest, NonTemporalCopyMatchesMemcpy) {
+    // Covers copies shorter than a cache line, and every alignment of the
+    // source and destination relative to one.
+    const size_t max_size = 1000;
+    vector<uint8_t> source(max_size + 64);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    vector<uint8_t> destination(max_size + 128);
+
+    for (size_t offset = 0; offset < 64; offset += 3) {
+        for (size_t size = 0; size <= max_size; size += 31) {
+            fill(destination.begin(), destination.end(), 0);
+            nonTemporalCopy(destination.data() + offset,
+                            source.data() + offset / 2, size);
+            ASSERT_TRUE(equal(source.begin() + offset / 2,
+                              source.begin() + offset / 2 + size,
+                              destination.begin() + offset));
+            // Nothing outside the destination range was touched.
+            ASSERT_TRUE(all_of(destination.begin(),
+                               destination.begin() + offset,
+                               [](uint8_t byte) { return byte == 0; }));
+            ASSERT_TRUE(all_of(destination.begin() + offset + size,
+                               destination.end(),
+                               [](uint8_t byte) { return byte == 0; }));
+        }
+    }
+}
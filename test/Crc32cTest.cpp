@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Crc32c.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Computes the checksum one bit at a time, as a reference.
+ */
+uint32_t referenceCrc32c(const uint8_t *data, size_t size) {
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (crc & 1 ? 0x82f63b78u : 0);
+        }
+    }
+    return ~crc;
+}
+
+} // namespace
+
+TEST(Crc32cTest, MatchesKnownValues) {
+    ASSERT_EQ(crc32c("123456789", 9), 0xe3069283u);
+    ASSERT_EQ(crc32c(nullptr, 0), 0u);
+
+    // The iSCSI test vectors from RFC 3720.
+    vector<uint8_t> data(32, 0);
+    ASSERT_EQ(crc32c(data.data(), data.size()), 0x8a9136aau);
+    fill(data.begin(), data.end(), 0xff);
+    ASSERT_EQ(crc32c(data.data(), data.size()), 0x62a8ab43u);
+    iota(data.begin(), data.end(), 0);
+    ASSERT_EQ(crc32c(data.data(), data.size()), 0x46dd794eu);
+}
+
+TEST(Crc32cTest, MatchesReferenceAtEverySizeAndAlignment) {
+    vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t size = 0; size + offset <= data.size(); size += 13) {
+            ASSERT_EQ(crc32c(data.data() + offset, size),
+                      referenceCrc32c(data.data() + offset, size));
+        }
+    }
+}
+
+TEST(Crc32cTest, ChainsAcrossPieces) {
+    const char text[] = "The quick brown fox jumps over the lazy dog";
+    auto size = strlen(text);
+    auto whole = crc32c(text, size);
+    for (size_t split = 0; split <= size; ++split) {
+        ASSERT_EQ(crc32c(text + split, size - split, crc32c(text, split)),
+                  whole);
+    }
+}
+
+TEST(Crc32cTest, CopyComputesSameChecksum) {
+    vector<char> source(1000);
+    iota(source.begin(), source.end(), 0);
+    for (size_t size : {0, 1, 7, 8, 9, 63, 64, 65, 1000}) {
+        vector<char> destination(size + 1, 'x');
+        ASSERT_EQ(copyCrc32c(destination.data(), source.data(), size),
+                  crc32c(source.data(), size));
+        ASSERT_TRUE(equal(source.begin(), source.begin() + size,
+                          destination.begin()));
+        ASSERT_EQ(destination[size], 'x');
+    }
+}
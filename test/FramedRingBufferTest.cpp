@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "FramedRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class FramedRingBufferTest : public testing::Test {
+protected:
+    FramedRingBufferTest()
+        : m_ring_buffer(m_buffer.data(), BUFFER_SIZE),
+          m_framed(m_ring_buffer) {}
+
+    static const size_t BUFFER_SIZE = 300;
+
+    array<char, BUFFER_SIZE> m_buffer;
+    RingBuffer m_ring_buffer;
+    FramedRingBuffer m_framed;
+
+    vector<char> makeMessage(size_t size, char first) {
+        vector<char> message(size);
+        iota(message.begin(), message.end(), first);
+        return message;
+    }
+};
+
+const size_t FramedRingBufferTest::BUFFER_SIZE;
+
+TEST_F(FramedRingBufferTest, TestFramedSize) {
+    ASSERT_EQ(FramedRingBuffer::getFramedSize(0), 1u);
+    ASSERT_EQ(FramedRingBuffer::getFramedSize(127), 128u);
+    ASSERT_EQ(FramedRingBuffer::getFramedSize(128), 130u);
+    ASSERT_EQ(FramedRingBuffer::getFramedSize(16383), 16385u);
+    ASSERT_EQ(FramedRingBuffer::getFramedSize(16384), 16387u);
+}
+
+TEST_F(FramedRingBufferTest, TestEmpty) {
+    size_t size = 1;
+    char destination[16];
+    ConstSpanPair spans;
+    ASSERT_TRUE(m_framed.isEmpty());
+    ASSERT_FALSE(m_framed.peekMessageSize(size));
+    ASSERT_FALSE(m_framed.peekMessage(destination, sizeof(destination), size));
+    ASSERT_FALSE(m_framed.peekMessageSpans(spans));
+    ASSERT_FALSE(m_framed.readMessage(destination, sizeof(destination), size));
+    ASSERT_FALSE(m_framed.skipMessage());
+}
+
+TEST_F(FramedRingBufferTest, TestWriteRead) {
+    auto small = makeMessage(10, 'a');
+    auto large = makeMessage(200, 0);
+    ASSERT_TRUE(m_framed.writeMessage(small.data(), small.size()));
+    ASSERT_TRUE(m_framed.writeMessage(nullptr, 0));
+    ASSERT_TRUE(m_framed.writeMessage(large.data(), large.size()));
+    ASSERT_EQ(m_ring_buffer.getReadableByteCount(), 11u + 1u + 202u);
+
+    // Too big to fit alongside the others: nothing is written.
+    ASSERT_FALSE(m_framed.writeMessage(large.data(), 90));
+    ASSERT_EQ(m_ring_buffer.getReadableByteCount(), 214u);
+
+    size_t size = 0;
+    vector<char> destination(BUFFER_SIZE);
+    ASSERT_TRUE(m_framed.peekMessageSize(size));
+    ASSERT_EQ(size, small.size());
+
+    // Too small a destination leaves the message in place.
+    ASSERT_FALSE(m_framed.readMessage(destination.data(), 9, size));
+    ASSERT_EQ(size, small.size());
+
+    ASSERT_TRUE(
+        m_framed.readMessage(destination.data(), destination.size(), size));
+    ASSERT_EQ(vector<char>(destination.begin(), destination.begin() + size),
+              small);
+    ASSERT_TRUE(m_framed.readMessage(nullptr, 0, size));
+    ASSERT_EQ(size, 0u);
+    ASSERT_TRUE(
+        m_framed.peekMessage(destination.data(), destination.size(), size));
+    ASSERT_EQ(vector<char>(destination.begin(), destination.begin() + size),
+              large);
+    ASSERT_TRUE(m_framed.skipMessage());
+    ASSERT_TRUE(m_framed.isEmpty());
+}
+
+TEST_F(FramedRingBufferTest, TestWrapAround) {
+    // Walk messages of assorted sizes around the buffer many times, so that
+    // headers and payloads land on both sides of the wrap.
+    vector<vector<char>> in_flight;
+    size_t next_size = 0;
+    for (int i = 0; i < 500; ++i) {
+        auto message = makeMessage(next_size, static_cast<char>(i));
+        if (m_framed.writeMessage(message.data(), message.size())) {
+            in_flight.push_back(message);
+            next_size = (next_size * 7 + 13) % 160;
+        } else {
+            ASSERT_FALSE(in_flight.empty());
+            ConstSpanPair spans;
+            ASSERT_TRUE(m_framed.peekMessageSpans(spans));
+            ASSERT_EQ(spans.size(), in_flight.front().size());
+            string joined(spans.first.data, spans.first.size);
+            joined.append(spans.second.data, spans.second.size);
+            ASSERT_EQ(joined, string(in_flight.front().begin(),
+                                     in_flight.front().end()));
+
+            vector<char> destination(BUFFER_SIZE);
+            size_t size;
+            if (i % 2 == 0) {
+                ASSERT_TRUE(m_framed.readMessage(destination.data(),
+                                                 destination.size(), size));
+                destination.resize(size);
+                ASSERT_EQ(destination, in_flight.front());
+            } else {
+                ASSERT_TRUE(m_framed.skipMessage());
+            }
+            in_flight.erase(in_flight.begin());
+        }
+    }
+}
+
+TEST_F(FramedRingBufferTest, TestOverwrite) {
+    // Messages of 99 bytes take 100 bytes with their header, so three fill
+    // the ring buffer and each one after that evicts the oldest.
+    for (int i = 0; i < 10; ++i) {
+        auto message = makeMessage(99, static_cast<char>(i));
+        ASSERT_TRUE(m_framed.overwriteMessage(message.data(), message.size()));
+        ASSERT_EQ(m_framed.getDroppedMessageCount(),
+                  static_cast<uint64_t>(max(i - 2, 0)));
+    }
+
+    vector<char> destination(BUFFER_SIZE);
+    size_t size;
+    for (int i = 7; i < 10; ++i) {
+        ASSERT_TRUE(
+            m_framed.readMessage(destination.data(), destination.size(), size));
+        destination.resize(size);
+        ASSERT_EQ(destination, makeMessage(99, static_cast<char>(i)));
+        destination.resize(BUFFER_SIZE);
+    }
+    ASSERT_TRUE(m_framed.isEmpty());
+
+    // A big message evicts as many small ones as it takes. Messages of one
+    // byte take two bytes with their header.
+    for (size_t i = 0; i < BUFFER_SIZE / 2; ++i) {
+        ASSERT_TRUE(m_framed.overwriteMessage("x", 1));
+    }
+    ASSERT_EQ(m_framed.getDroppedMessageCount(), 7u);
+    auto large = makeMessage(250, 0);
+    ASSERT_TRUE(m_framed.overwriteMessage(large.data(), large.size()));
+    ASSERT_EQ(m_framed.getDroppedMessageCount(), 7u + 126u);
+    for (int i = 0; i < 24; ++i) {
+        ASSERT_TRUE(m_framed.peekMessageSize(size));
+        ASSERT_EQ(size, 1u);
+        ASSERT_TRUE(m_framed.skipMessage());
+    }
+    ASSERT_TRUE(
+        m_framed.readMessage(destination.data(), destination.size(), size));
+    ASSERT_EQ(size, large.size());
+    ASSERT_TRUE(m_framed.isEmpty());
+
+    // A message larger than the ring buffer cannot be written at all.
+    vector<char> huge(BUFFER_SIZE);
+    ASSERT_FALSE(m_framed.overwriteMessage(huge.data(), huge.size()));
+}
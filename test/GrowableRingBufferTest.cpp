@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "GrowableRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+TEST(GrowableRingBufferTest, GrowsToFitBurst) {
+    GrowableRingBuffer ring_buffer(16);
+    vector<char> write_buffer(1000);
+    vector<char> read_buffer(1000);
+    iota(write_buffer.begin(), write_buffer.end(), 0);
+
+    ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data(), 10), 10u);
+    ASSERT_EQ(ring_buffer.getSize(), 16u);
+
+    // Doubling from 16 covers the remainder in one step.
+    ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data() + 10, 20), 20u);
+    ASSERT_EQ(ring_buffer.getSize(), 32u);
+
+    // A burst larger than double takes exactly what it needs.
+    ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data() + 30, 970), 970u);
+    ASSERT_EQ(ring_buffer.getSize(), 1000u);
+    ASSERT_TRUE(ring_buffer.getRingBuffer().isFull());
+
+    ASSERT_EQ(ring_buffer.getRingBuffer().readBytes(read_buffer.data(), 1000),
+              1000u);
+    ASSERT_EQ(read_buffer, write_buffer);
+}
+
+TEST(GrowableRingBufferTest, GrowsWrappedData) {
+    GrowableRingBuffer ring_buffer(8);
+    auto &ring = ring_buffer.getRingBuffer();
+    const char first[] = "abcdefgh";
+    char read_buffer[16];
+
+    // Leave "ghij" split around the end of the buffer.
+    ASSERT_EQ(ring_buffer.writeBytes(first, 8), 8u);
+    ASSERT_EQ(ring.discardBytes(6), 6u);
+    ASSERT_EQ(ring_buffer.writeBytes("ij", 2), 2u);
+    ASSERT_FALSE(ring.isContiguous());
+
+    ASSERT_EQ(ring_buffer.writeBytes("klmnop", 6), 6u);
+    ASSERT_EQ(ring_buffer.getSize(), 16u);
+    ASSERT_EQ(ring.readBytes(read_buffer, sizeof(read_buffer)), 10u);
+    ASSERT_EQ(string(read_buffer, 10), "ghijklmnop");
+}
+
+TEST(GrowableRingBufferTest, StopsAtMaximumSize) {
+    GrowableRingBuffer ring_buffer(8, 20);
+    vector<char> write_buffer(30, 'x');
+    ASSERT_EQ(ring_buffer.getMaximumSize(), 20u);
+
+    ASSERT_TRUE(ring_buffer.reserve(12));
+    ASSERT_EQ(ring_buffer.getSize(), 16u);
+    ASSERT_FALSE(ring_buffer.reserve(21));
+    ASSERT_EQ(ring_buffer.getSize(), 16u);
+
+    // A write that cannot fit grows as far as it can, then comes up short.
+    ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data(), 30), 20u);
+    ASSERT_EQ(ring_buffer.getSize(), 20u);
+    ASSERT_TRUE(ring_buffer.reserve(0));
+    ASSERT_FALSE(ring_buffer.reserve(1));
+}
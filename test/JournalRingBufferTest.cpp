@@ -0,0 +1,283 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "JournalRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+const size_t CAPACITY = 64;
+
+/**
+ * Returns the contents of a ring buffer, without removing them.
+ */
+vector<uint8_t> peekAll(const RingBuffer &ring_buffer) {
+    vector<uint8_t> bytes(ring_buffer.getReadableByteCount());
+    auto spans = ring_buffer.readableSpans();
+    copy(spans.first.data, spans.first.data + spans.first.size,
+         bytes.begin());
+    copy(spans.second.data, spans.second.data + spans.second.size,
+         bytes.begin() + spans.first.size);
+    return bytes;
+}
+
+/**
+ * Returns the bytes from @p first up to but excluding @p last.
+ */
+vector<uint8_t> sequence(uint8_t first, uint8_t last) {
+    vector<uint8_t> bytes(last - first);
+    iota(bytes.begin(), bytes.end(), first);
+    return bytes;
+}
+
+} // namespace
+
+class JournalRingBufferTest : public testing::Test {
+protected:
+    JournalRingBufferTest() {
+#if defined(__unix__) || defined(__APPLE__)
+        auto pid = static_cast<long>(getpid());
+#else
+        long pid = 0;
+#endif
+        auto test = testing::UnitTest::GetInstance()->current_test_info();
+        m_path = testing::TempDir() + "hdc-ringbuffer-test-" +
+                 to_string(pid) + "-" + test->name() + ".ring";
+        remove(m_path.c_str());
+    }
+
+    ~JournalRingBufferTest() override { remove(m_path.c_str()); }
+
+    /**
+     * Overwrites a byte of the file.
+     */
+    void corrupt(size_t offset) {
+        fstream file(m_path, ios::in | ios::out | ios::binary);
+        file.seekg(static_cast<streamoff>(offset));
+        auto byte = static_cast<char>(file.get() ^ 0x5a);
+        file.seekp(static_cast<streamoff>(offset));
+        file.put(byte);
+    }
+
+    string m_path;
+};
+
+TEST_F(JournalRingBufferTest, CreatesEmptyJournal) {
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isValid());
+    ASSERT_FALSE(journal.isRecovered());
+    ASSERT_EQ(journal.getCapacity(), CAPACITY);
+    ASSERT_EQ(journal.getEpoch(), 1u);
+    ASSERT_TRUE(journal.getRingBuffer().isEmpty());
+    ASSERT_EQ(journal.getRingBuffer().getWritableByteCount(), CAPACITY);
+
+    ifstream file(m_path, ios::binary | ios::ate);
+    ASSERT_EQ(static_cast<size_t>(file.tellg()),
+              JournalRingBuffer::HEADER_SIZE + CAPACITY);
+}
+
+TEST_F(JournalRingBufferTest, RecoversCommittedContents) {
+    auto bytes = sequence(0, 80);
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_TRUE(journal.isValid());
+        // Leave bytes that wrap around the end of the buffer.
+        ASSERT_EQ(journal.writeBytes(bytes.data(), 50), 50u);
+        ASSERT_EQ(journal.getRingBuffer().discardBytes(30), 30u);
+        ASSERT_EQ(journal.writeBytes(bytes.data() + 50, 30), 30u);
+        ASSERT_FALSE(journal.getRingBuffer().isContiguous());
+        journal.commit();
+        ASSERT_EQ(journal.getEpoch(), 2u);
+    }
+
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isValid());
+    ASSERT_TRUE(journal.isRecovered());
+    ASSERT_EQ(journal.getEpoch(), 2u);
+    ASSERT_EQ(peekAll(journal.getRingBuffer()), sequence(30, 80));
+
+    // The free space follows the recovered bytes.
+    ASSERT_EQ(journal.writeBytes(bytes.data(), CAPACITY), 14u);
+    ASSERT_TRUE(journal.getRingBuffer().isFull());
+}
+
+TEST_F(JournalRingBufferTest, LosesChangesSinceLastCommit) {
+    auto bytes = sequence(0, 20);
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_EQ(journal.writeBytes(bytes.data(), 10), 10u);
+        journal.commit();
+        ASSERT_EQ(journal.writeBytes(bytes.data() + 10, 10), 10u);
+        ASSERT_EQ(journal.getRingBuffer().discardBytes(5), 5u);
+    }
+
+    // Bytes written since are lost, and bytes read since are readable again.
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isRecovered());
+    ASSERT_EQ(peekAll(journal.getRingBuffer()), sequence(0, 10));
+}
+
+TEST_F(JournalRingBufferTest, KeepsCommittedBytesAfterReading) {
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_EQ(journal.writeBytes("AAAABBBB", 8), 8u);
+        journal.commit();
+        char destination[8];
+        ASSERT_EQ(journal.getRingBuffer().readBytes(destination, 8), 8u);
+        // The emptied ring buffer would write over the committed bytes.
+        ASSERT_EQ(journal.getWritableByteCount(), 0u);
+        ASSERT_EQ(journal.writeBytes("XXXX", 4), 0u);
+    }
+
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isRecovered());
+    ASSERT_EQ(peekAll(journal.getRingBuffer()),
+              vector<uint8_t>({'A', 'A', 'A', 'A', 'B', 'B', 'B', 'B'}));
+
+    // Reading, then committing, frees the space again.
+    ASSERT_EQ(journal.getRingBuffer().discardBytes(8), 8u);
+    journal.commit();
+    ASSERT_EQ(journal.getWritableByteCount(), CAPACITY);
+    ASSERT_EQ(journal.writeBytes("XXXX", 4), 4u);
+}
+
+TEST_F(JournalRingBufferTest, WritesAroundCommittedBytes) {
+    auto bytes = sequence(0, CAPACITY);
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_EQ(journal.writeBytes(bytes.data(), 20), 20u);
+    ASSERT_EQ(journal.getRingBuffer().discardBytes(10), 10u);
+    journal.commit();
+    ASSERT_EQ(journal.getRingBuffer().discardBytes(5), 5u);
+    // The committed bytes start at offset 10, so the write wraps around the
+    // end of the buffer and stops there, short of the 5 bytes just read.
+    ASSERT_EQ(journal.getWritableByteCount(), CAPACITY - 10);
+    ASSERT_EQ(journal.writeBytes(bytes.data(), CAPACITY), CAPACITY - 10);
+    ASSERT_EQ(journal.getRingBuffer().getWritableByteCount(), 5u);
+}
+
+TEST_F(JournalRingBufferTest, FlushWritesBackDirtyBytes) {
+    auto bytes = sequence(0, 40);
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_EQ(journal.writeBytes(bytes.data(), 30), 30u);
+        ASSERT_EQ(journal.getDirtyByteCount(), 30u);
+        ASSERT_TRUE(journal.flush());
+        ASSERT_EQ(journal.getDirtyByteCount(), 0u);
+        ASSERT_EQ(journal.getEpoch(), 2u);
+
+        // Bytes read before a flush need no writing back.
+        ASSERT_EQ(journal.writeBytes(bytes.data() + 30, 10), 10u);
+        ASSERT_EQ(journal.getRingBuffer().discardBytes(35), 35u);
+        ASSERT_EQ(journal.getDirtyByteCount(), 5u);
+        ASSERT_TRUE(journal.flush());
+        ASSERT_EQ(journal.getEpoch(), 3u);
+    }
+
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isRecovered());
+    ASSERT_EQ(journal.getEpoch(), 3u);
+    ASSERT_EQ(peekAll(journal.getRingBuffer()), sequence(35, 40));
+}
+
+TEST_F(JournalRingBufferTest, FallsBackToOlderSlot) {
+    auto bytes = sequence(0, 20);
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_EQ(journal.writeBytes(bytes.data(), 10), 10u);
+        journal.commit();
+        ASSERT_EQ(journal.writeBytes(bytes.data() + 10, 10), 10u);
+        journal.commit();
+        ASSERT_EQ(journal.getEpoch(), 3u);
+    }
+
+    // Tear the count in the slot of epoch 3, the second of two 32-byte slots
+    // after the 16 bytes of magic number, version and capacity.
+    corrupt(16 + 32 + 16);
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_TRUE(journal.isValid());
+        ASSERT_EQ(journal.getEpoch(), 2u);
+        ASSERT_EQ(peekAll(journal.getRingBuffer()), sequence(0, 10));
+    }
+
+    // Without an intact slot, there is nothing to recover.
+    corrupt(16 + 16);
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_FALSE(journal.isValid());
+}
+
+TEST_F(JournalRingBufferTest, RejectsOtherFiles) {
+    {
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        ASSERT_TRUE(journal.isValid());
+    }
+    JournalRingBuffer larger(m_path.c_str(), 2 * CAPACITY);
+    ASSERT_FALSE(larger.isValid());
+
+    // A file of the right size that is not a journal.
+    corrupt(0);
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_FALSE(journal.isValid());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST_F(JournalRingBufferTest, SurvivesProcessCrash) {
+    auto bytes = sequence(0, 20);
+    auto pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        // Die right after committing, without unmapping.
+        JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+        journal.writeBytes(bytes.data(), bytes.size());
+        journal.commit();
+        _exit(journal.isValid() ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+
+    JournalRingBuffer journal(m_path.c_str(), CAPACITY);
+    ASSERT_TRUE(journal.isRecovered());
+    ASSERT_EQ(peekAll(journal.getRingBuffer()), bytes);
+}
+
+#endif
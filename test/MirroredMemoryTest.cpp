@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "MirroredMemory.h"
+#include "RingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+TEST(MirroredMemoryTest, RoundsUpToGranularity) {
+    MirroredMemory memory(1);
+    ASSERT_TRUE(memory.isValid());
+    ASSERT_EQ(memory.getSize(), MirroredMemory::getGranularity());
+}
+
+TEST(MirroredMemoryTest, ZeroSizeIsInvalid) {
+    MirroredMemory memory(0);
+    ASSERT_FALSE(memory.isValid());
+    ASSERT_EQ(memory.getBuffer(), nullptr);
+    ASSERT_EQ(memory.getSize(), 0u);
+}
+
+TEST(MirroredMemoryTest, MirrorAliasesBuffer) {
+    MirroredMemory memory(1);
+    ASSERT_TRUE(memory.isValid());
+    auto buffer = static_cast<char *>(memory.getBuffer());
+    auto size = memory.getSize();
+
+    buffer[0] = 'a';
+    buffer[size - 1] = 'b';
+    ASSERT_EQ(buffer[size], 'a');
+    ASSERT_EQ(buffer[2 * size - 1], 'b');
+
+    buffer[size + 1] = 'c';
+    ASSERT_EQ(buffer[1], 'c');
+}
+
+TEST(MirroredMemoryTest, MoveTransfersMapping) {
+    MirroredMemory memory(1);
+    ASSERT_TRUE(memory.isValid());
+    auto buffer = memory.getBuffer();
+    auto size = memory.getSize();
+
+    MirroredMemory other(move(memory));
+    ASSERT_FALSE(memory.isValid());
+    ASSERT_EQ(other.getBuffer(), buffer);
+    ASSERT_EQ(other.getSize(), size);
+
+    memory = move(other);
+    ASSERT_TRUE(memory.isValid());
+    ASSERT_FALSE(other.isValid());
+    ASSERT_EQ(memory.getBuffer(), buffer);
+}
+
+TEST(MirroredMemoryTest, RingBufferNeverSplitsRegions) {
+    MirroredMemory memory(1);
+    ASSERT_TRUE(memory.isValid());
+    auto size = memory.getSize();
+    RingBuffer ring_buffer(memory.getBuffer(), size, true);
+
+    vector<char> write_buffer(size);
+    vector<char> read_buffer(size);
+    iota(write_buffer.begin(), write_buffer.end(), 0);
+
+    for (size_t i = 0; i < size; i += 97) {
+        // Move the read and write locations to i, then write most of the
+        // buffer so that the data wraps around.
+        auto count = size - size / 8;
+        ring_buffer.clear();
+        ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data(), i), i);
+        ASSERT_EQ(ring_buffer.discardBytes(i), i);
+
+        auto free_spans = ring_buffer.reserveWrite(size);
+        ASSERT_EQ(free_spans.first.size, size);
+        ASSERT_EQ(free_spans.second.size, 0u);
+
+        ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data(), count), count);
+        auto spans = ring_buffer.readableSpans();
+        ASSERT_EQ(spans.first.size, count);
+        ASSERT_EQ(spans.second.size, 0u);
+        ASSERT_TRUE(equal(spans.first.data, spans.first.data + count,
+                          write_buffer.begin()));
+
+        free_spans = ring_buffer.reserveWrite(size);
+        ASSERT_EQ(free_spans.first.size, size - count);
+        ASSERT_EQ(free_spans.second.size, 0u);
+
+        ASSERT_EQ(ring_buffer.peekBytesAt(read_buffer.data(), size, 1),
+                  count - 1);
+        ASSERT_TRUE(equal(read_buffer.begin(), read_buffer.begin() + count - 1,
+                          write_buffer.begin() + 1));
+        ASSERT_EQ(ring_buffer.readBytes(read_buffer.data(), size), count);
+        ASSERT_TRUE(equal(read_buffer.begin(), read_buffer.begin() + count,
+                          write_buffer.begin()));
+        ASSERT_TRUE(ring_buffer.isEmpty());
+    }
+}
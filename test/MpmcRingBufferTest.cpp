@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "MpmcRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class MpmcRingBufferTest : public testing::Test {
+protected:
+    MpmcRingBufferTest()
+        : m_buffer(MpmcRingBuffer::getBufferSize(SLOT_COUNT, SLOT_SIZE) /
+                   sizeof(size_t)),
+          m_ring_buffer(m_buffer.data(), m_buffer.size() * sizeof(size_t),
+                        SLOT_SIZE) {}
+
+    static const size_t SLOT_COUNT = 8;
+    static const size_t SLOT_SIZE = 13;
+
+    vector<size_t> m_buffer;
+    MpmcRingBuffer m_ring_buffer;
+};
+
+const size_t MpmcRingBufferTest::SLOT_COUNT;
+const size_t MpmcRingBufferTest::SLOT_SIZE;
+
+TEST_F(MpmcRingBufferTest, TestInitialState) {
+    ASSERT_EQ(m_ring_buffer.getSlotCount(), SLOT_COUNT);
+    ASSERT_EQ(m_ring_buffer.getSlotSize(), SLOT_SIZE);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+    char destination[SLOT_SIZE];
+    size_t size;
+    ASSERT_FALSE(m_ring_buffer.tryRead(destination, sizeof(destination), size));
+}
+
+TEST_F(MpmcRingBufferTest, RoundsSlotCountDown) {
+    vector<size_t> buffer(
+        MpmcRingBuffer::getBufferSize(SLOT_COUNT * 2 - 1, SLOT_SIZE) /
+        sizeof(size_t));
+    MpmcRingBuffer ring_buffer(buffer.data(), buffer.size() * sizeof(size_t),
+                               SLOT_SIZE);
+    ASSERT_EQ(ring_buffer.getSlotCount(), SLOT_COUNT);
+}
+
+TEST_F(MpmcRingBufferTest, SingleSlotRejectsSecondWrite) {
+    vector<size_t> buffer(MpmcRingBuffer::getBufferSize(1, SLOT_SIZE) /
+                          sizeof(size_t));
+    MpmcRingBuffer ring_buffer(buffer.data(), buffer.size() * sizeof(size_t),
+                               SLOT_SIZE);
+    ASSERT_EQ(ring_buffer.getSlotCount(), 1u);
+    char destination[SLOT_SIZE];
+    size_t size;
+    for (int lap = 0; lap < 3; ++lap) {
+        ASSERT_TRUE(ring_buffer.tryWrite("first", 5));
+        ASSERT_FALSE(ring_buffer.tryWrite("second", 6));
+        ASSERT_TRUE(
+            ring_buffer.tryRead(destination, sizeof(destination), size));
+        ASSERT_EQ(string(destination, size), "first");
+        ASSERT_FALSE(
+            ring_buffer.tryRead(destination, sizeof(destination), size));
+    }
+}
+
+TEST_F(MpmcRingBufferTest, TestFillAndDrain) {
+    char message[SLOT_SIZE];
+    char destination[SLOT_SIZE];
+    size_t size;
+    for (int lap = 0; lap < 3; ++lap) {
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            memset(message, static_cast<int>(i), sizeof(message));
+            ASSERT_TRUE(m_ring_buffer.tryWrite(message, i % (SLOT_SIZE + 1)));
+            ASSERT_EQ(m_ring_buffer.getReadableCount(), i + 1);
+        }
+        ASSERT_FALSE(m_ring_buffer.tryWrite(message, 1));
+
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            memset(destination, -1, sizeof(destination));
+            ASSERT_TRUE(
+                m_ring_buffer.tryRead(destination, sizeof(destination), size));
+            ASSERT_EQ(size, i % (SLOT_SIZE + 1));
+            for (size_t k = 0; k < size; ++k) {
+                ASSERT_EQ(destination[k], static_cast<char>(i));
+            }
+        }
+        ASSERT_TRUE(m_ring_buffer.isEmpty());
+    }
+}
+
+TEST_F(MpmcRingBufferTest, TruncatesToCapacity) {
+    const char message[] = "0123456789";
+    char destination[4] = {};
+    size_t size;
+    ASSERT_TRUE(m_ring_buffer.tryWrite(message, 10));
+    ASSERT_TRUE(m_ring_buffer.tryRead(destination, 4, size));
+    ASSERT_EQ(size, 10u);
+    ASSERT_EQ(string(destination, 4), "0123");
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST_F(MpmcRingBufferTest, TestProducersConsumers) {
+    // Every message written by any producer is read exactly once by one of
+    // the consumers, and each consumer sees each producer's messages in order.
+    const unsigned PRODUCERS = 3;
+    const unsigned CONSUMERS = 2;
+    const uint32_t MESSAGES = 20000;
+
+    atomic<uint32_t> remaining(PRODUCERS * MESSAGES);
+    vector<vector<uint32_t>> received(PRODUCERS * CONSUMERS);
+    vector<thread> threads;
+    for (unsigned p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&, p] {
+            for (uint32_t i = 0; i < MESSAGES; ++i) {
+                uint32_t message[2] = {p, i};
+                while (!m_ring_buffer.tryWrite(message, sizeof(message))) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+    for (unsigned c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&, c] {
+            while (remaining.load() > 0) {
+                uint32_t message[2];
+                size_t size;
+                if (!m_ring_buffer.tryRead(message, sizeof(message), size)) {
+                    this_thread::yield();
+                    continue;
+                }
+                received[message[0] * CONSUMERS + c].push_back(message[1]);
+                --remaining;
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (unsigned p = 0; p < PRODUCERS; ++p) {
+        vector<bool> seen(MESSAGES);
+        for (unsigned c = 0; c < CONSUMERS; ++c) {
+            auto &messages = received[p * CONSUMERS + c];
+            for (size_t k = 0; k < messages.size(); ++k) {
+                ASSERT_FALSE(seen[messages[k]]);
+                seen[messages[k]] = true;
+                if (k > 0) {
+                    ASSERT_LT(messages[k - 1], messages[k]);
+                }
+            }
+        }
+        for (uint32_t i = 0; i < MESSAGES; ++i) {
+            ASSERT_TRUE(seen[i]);
+        }
+    }
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
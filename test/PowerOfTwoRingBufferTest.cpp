@@ -0,0 +1,185 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "PowerOfTwoRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class PowerOfTwoRingBufferTest : public testing::Test {
+protected:
+    PowerOfTwoRingBufferTest() : m_ring_buffer(m_buffer.data(), BUFFER_SIZE) {}
+
+    static const size_t ZERO_SIZE = 0;
+    static const size_t BUFFER_SIZE = 64;
+    static const size_t EXTRA_BUFFER_SIZE = 3;
+
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_check_buffer;
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_read_buffer;
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_write_buffer;
+    array<int8_t, BUFFER_SIZE> m_buffer;
+    PowerOfTwoRingBuffer m_ring_buffer;
+
+    void checkState(bool empty, bool full, size_t readable_count,
+                    size_t writable_count) const {
+        ASSERT_EQ(m_ring_buffer.isEmpty(), empty);
+        ASSERT_EQ(m_ring_buffer.isFull(), full);
+        ASSERT_EQ(m_ring_buffer.getReadableByteCount(), readable_count);
+        ASSERT_EQ(m_ring_buffer.getWritableByteCount(), writable_count);
+    }
+
+    void testRead(size_t requested, size_t expected) {
+        ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), requested),
+                  expected);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+    }
+
+    void testWrite(size_t requested, size_t expected) {
+        ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), requested),
+                  expected);
+    }
+
+    void testPeekAt(size_t requested, size_t where, size_t expected) {
+        ASSERT_EQ(
+            m_ring_buffer.peekBytesAt(m_read_buffer.data(), requested, where),
+            expected);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+    }
+};
+
+const size_t PowerOfTwoRingBufferTest::ZERO_SIZE;
+const size_t PowerOfTwoRingBufferTest::BUFFER_SIZE;
+const size_t PowerOfTwoRingBufferTest::EXTRA_BUFFER_SIZE;
+
+TEST_F(PowerOfTwoRingBufferTest, IsInitiallyEmpty) {
+    checkState(true, false, 0, BUFFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.getSize(), BUFFER_SIZE);
+}
+
+TEST_F(PowerOfTwoRingBufferTest, TestWriteReadClear) {
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Write up to i items to the ring buffer.
+            auto expected_write = min(i, BUFFER_SIZE);
+            iota(m_write_buffer.begin(), m_write_buffer.begin() + i, 0);
+            testWrite(i, expected_write);
+            checkState(expected_write == ZERO_SIZE,
+                       expected_write == BUFFER_SIZE, expected_write,
+                       BUFFER_SIZE - expected_write);
+
+            // Read up to j items from the ring buffer.
+            auto expected_read = min(j, expected_write);
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + expected_read,
+                 0);
+            fill(m_check_buffer.begin() + expected_read, m_check_buffer.end(),
+                 -1);
+            testRead(j, expected_read);
+            checkState(expected_write - expected_read == ZERO_SIZE,
+                       expected_write - expected_read == BUFFER_SIZE,
+                       expected_write - expected_read,
+                       BUFFER_SIZE - expected_write + expected_read);
+
+            // Clear the ring buffer for next iteration. The counters keep
+            // running, so later iterations also exercise wrapping.
+            m_ring_buffer.clear();
+            checkState(true, false, ZERO_SIZE, BUFFER_SIZE);
+        }
+    }
+}
+
+TEST_F(PowerOfTwoRingBufferTest, TestDiscardPeekAt) {
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Write up to i items to the ring buffer.
+            auto expected_write = min(i, BUFFER_SIZE);
+            iota(m_write_buffer.begin(), m_write_buffer.begin() + i, 0);
+            testWrite(i, expected_write);
+
+            // Peek up to j items from the ring buffer at end of the buffer.
+            auto expected_peek = min(j, expected_write);
+            auto where = j < expected_write ? expected_write - j : ZERO_SIZE;
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + expected_peek,
+                 static_cast<int8_t>(where));
+            fill(m_check_buffer.begin() + expected_peek, m_check_buffer.end(),
+                 -1);
+            testPeekAt(j, where, expected_peek);
+
+            // Discard up to j items from the ring buffer.
+            auto expected_discard = min(j, expected_write);
+            ASSERT_EQ(m_ring_buffer.discardBytes(j), expected_discard);
+            checkState(expected_write - expected_discard == ZERO_SIZE,
+                       expected_write - expected_discard == BUFFER_SIZE,
+                       expected_write - expected_discard,
+                       BUFFER_SIZE - expected_write + expected_discard);
+
+            m_ring_buffer.clear();
+        }
+    }
+}
+
+TEST_F(PowerOfTwoRingBufferTest, TestSpans) {
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j <= BUFFER_SIZE; ++j) {
+            // Move the counters on by i, then reserve and commit j bytes.
+            testWrite(i, i);
+            m_ring_buffer.clear();
+            auto free_spans = m_ring_buffer.reserveWrite(j);
+            ASSERT_EQ(free_spans.size(), j);
+            auto offset = static_cast<size_t>(
+                free_spans.first.data -
+                reinterpret_cast<char *>(m_buffer.data()));
+            ASSERT_EQ(free_spans.second.size, offset + j > BUFFER_SIZE
+                                                  ? offset + j - BUFFER_SIZE
+                                                  : ZERO_SIZE);
+            iota(free_spans.first.data,
+                 free_spans.first.data + free_spans.first.size, 0);
+            iota(free_spans.second.data,
+                 free_spans.second.data + free_spans.second.size,
+                 static_cast<char>(free_spans.first.size));
+            m_ring_buffer.commitWrite(j);
+
+            // The readable spans should match the reserved ones.
+            auto spans = m_ring_buffer.readableSpans();
+            ASSERT_EQ(spans.first.data, free_spans.first.data);
+            ASSERT_EQ(spans.first.size, free_spans.first.size);
+            ASSERT_EQ(spans.second.size, free_spans.second.size);
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + j, 0);
+            fill(m_check_buffer.begin() + j, m_check_buffer.end(), -1);
+            testPeekAt(BUFFER_SIZE, 0, j);
+            m_ring_buffer.consume(j);
+            checkState(true, false, 0, BUFFER_SIZE);
+        }
+    }
+}
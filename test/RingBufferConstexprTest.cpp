@@ -0,0 +1,80 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "RingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+char buffer[16];
+
+constexpr size_t writableAfterRestore(size_t offset, size_t count) {
+    RingBuffer ring_buffer(buffer);
+    ring_buffer.restore(offset, count);
+    return ring_buffer.getWritableByteCount();
+}
+
+constexpr bool contiguousAfterRestore(size_t offset, size_t count) {
+    RingBuffer ring_buffer(buffer);
+    ring_buffer.restore(offset, count);
+    return ring_buffer.isContiguous();
+}
+
+constexpr bool emptyAfterClear() {
+    RingBuffer ring_buffer(buffer);
+    ring_buffer.restore(3, 5);
+    ring_buffer.clear();
+    return ring_buffer.isEmpty() && ring_buffer.getReadableByteCount() == 0;
+}
+
+// The index arithmetic runs at compile time.
+static_assert(RingBuffer(buffer).isEmpty(), "");
+static_assert(RingBuffer(buffer).getWritableByteCount() == sizeof(buffer), "");
+static_assert(writableAfterRestore(4, 10) == 6, "");
+static_assert(writableAfterRestore(15, 16) == 0, "");
+static_assert(contiguousAfterRestore(2, 8), "");
+static_assert(!contiguousAfterRestore(10, 8), "");
+static_assert(emptyAfterClear(), "");
+
+} // namespace
+
+TEST(RingBufferConstexprTest, ArrayConstructorUsesWholeArray) {
+    char array[8];
+    RingBuffer ring_buffer(array);
+    ASSERT_EQ(ring_buffer.getWritableByteCount(), sizeof(array));
+
+    const char data[] = "0123456789";
+    ASSERT_EQ(ring_buffer.writeBytes(data, 10), sizeof(array));
+    ASSERT_TRUE(ring_buffer.isFull());
+    char read[8] = {};
+    ASSERT_EQ(ring_buffer.readBytes(read, sizeof(read)), sizeof(read));
+    ASSERT_EQ(string(read, sizeof(read)), "01234567");
+}
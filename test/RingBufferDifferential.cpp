@@ -0,0 +1,459 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Implements the differential harness, which checks every ring buffer
+ * variant against a model.
+ */
+
+#include "RingBufferDifferential.h"
+
+#include "GrowableRingBuffer.h"
+#include "MirroredMemory.h"
+#include "MpmcRingBuffer.h"
+#include "PowerOfTwoRingBuffer.h"
+#include "RingBuffer.h"
+#include "SharedRingBuffer.h"
+#include "SpscRingBuffer.h"
+#include "TypedRingBuffer.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/** Returned by an adapter for an operation its variant does not have. */
+const size_t UNSUPPORTED = static_cast<size_t>(-1);
+
+enum Operation { WRITE, READ, PEEK_AT, DISCARD, CLEAR, OPERATION_COUNT };
+
+const char *const OPERATION_NAMES[] = {"writeBytes", "readBytes",
+                                       "peekBytesAt", "discardBytes",
+                                       "clear"};
+
+/**
+ * Hands out the input one byte at a time, then zeros.
+ */
+class Input {
+public:
+    Input(const uint8_t *data, size_t size)
+        : _data(data), _end(data + size) {}
+
+    bool isAtEnd() const { return _data == _end; }
+
+    uint8_t next() { return _data == _end ? 0 : *_data++; }
+
+    /**
+     * Returns a count from 0 to just over one and a half times a capacity, so
+     * that some operations ask for more than the ring buffer can hold.
+     */
+    size_t nextCount(size_t capacity) {
+        return next() * (capacity * 3 / 2 + 1) / 255;
+    }
+
+private:
+    const uint8_t *_data;
+    const uint8_t *_end;
+};
+
+/**
+ * The reference model: a double-ended queue with a capacity.
+ */
+class Model {
+public:
+    explicit Model(size_t capacity) : _capacity(capacity) {}
+
+    size_t size() const { return _bytes.size(); }
+
+    size_t write(const char *source, size_t count) {
+        count = min(count, _capacity - _bytes.size());
+        _bytes.insert(_bytes.end(), source, source + count);
+        return count;
+    }
+
+    size_t read(char *destination, size_t count) {
+        count = peekAt(destination, count, 0);
+        _bytes.erase(_bytes.begin(), _bytes.begin() + count);
+        return count;
+    }
+
+    size_t peekAt(char *destination, size_t count, size_t where) const {
+        if (where > _bytes.size()) {
+            return 0;
+        }
+        count = min(count, _bytes.size() - where);
+        copy_n(_bytes.begin() + where, count, destination);
+        return count;
+    }
+
+    size_t discard(size_t count) {
+        count = min(count, _bytes.size());
+        _bytes.erase(_bytes.begin(), _bytes.begin() + count);
+        return count;
+    }
+
+    void clear() { _bytes.clear(); }
+
+private:
+    size_t _capacity;
+    deque<char> _bytes;
+};
+
+/**
+ * Adapts a variant with the whole byte interface of RingBuffer.
+ */
+template <class Ring> class ByteAdapter {
+public:
+    explicit ByteAdapter(Ring &ring) : _ring(ring) {}
+
+    size_t size() const { return _ring.getReadableByteCount(); }
+
+    size_t write(const char *source, size_t count) {
+        return _ring.writeBytes(source, count);
+    }
+
+    size_t read(char *destination, size_t count) {
+        return _ring.readBytes(destination, count);
+    }
+
+    size_t peekAt(char *destination, size_t count, size_t where) {
+        return _ring.peekBytesAt(destination, count, where);
+    }
+
+    size_t discard(size_t count) { return _ring.discardBytes(count); }
+
+    void clear() { _ring.clear(); }
+
+private:
+    Ring &_ring;
+};
+
+/**
+ * Adapts a SharedRingBuffer, which has no peekBytesAt() or clear().
+ */
+class SharedAdapter {
+public:
+    explicit SharedAdapter(SharedRingBuffer &ring) : _ring(ring) {}
+
+    size_t size() const { return _ring.getReadableByteCount(); }
+
+    size_t write(const char *source, size_t count) {
+        return _ring.writeBytes(source, count);
+    }
+
+    size_t read(char *destination, size_t count) {
+        return _ring.readBytes(destination, count);
+    }
+
+    size_t peekAt(char *, size_t, size_t) { return UNSUPPORTED; }
+
+    size_t discard(size_t count) { return _ring.discardBytes(count); }
+
+    void clear() { _ring.discardBytes(_ring.getReadableByteCount()); }
+
+private:
+    SharedRingBuffer &_ring;
+};
+
+/**
+ * Adapts a GrowableRingBuffer, which writes through itself and does
+ * everything else through its RingBuffer.
+ */
+class GrowableAdapter : public ByteAdapter<RingBuffer> {
+public:
+    explicit GrowableAdapter(GrowableRingBuffer &ring)
+        : ByteAdapter<RingBuffer>(ring.getRingBuffer()), _growable(ring) {}
+
+    size_t write(const char *source, size_t count) {
+        return _growable.writeBytes(source, count);
+    }
+
+private:
+    GrowableRingBuffer &_growable;
+};
+
+/**
+ * Adapts a TypedRingBuffer of bytes, which has no peekBytesAt().
+ */
+template <size_t N> class TypedAdapter {
+public:
+    explicit TypedAdapter(TypedRingBuffer<char, N> &ring) : _ring(ring) {}
+
+    size_t size() const { return _ring.getReadableCount(); }
+
+    size_t write(const char *source, size_t count) {
+        return _ring.write(source, count);
+    }
+
+    size_t read(char *destination, size_t count) {
+        return _ring.read(destination, count);
+    }
+
+    size_t peekAt(char *, size_t, size_t) { return UNSUPPORTED; }
+
+    size_t discard(size_t count) { return _ring.discard(count); }
+
+    void clear() { _ring.clear(); }
+
+private:
+    TypedRingBuffer<char, N> &_ring;
+};
+
+string mismatch(const char *variant, size_t step, const char *operation,
+                const string &what) {
+    return string(variant) + ": step " + to_string(step) + ": " + operation +
+           " " + what;
+}
+
+/**
+ * Runs the operations against one byte variant and the model.
+ */
+template <class Adapter>
+string check(const char *variant, Adapter ring, size_t capacity,
+             const uint8_t *data, size_t size) {
+    Model model(capacity);
+    Input input(data, size);
+    auto limit = capacity * 3 / 2 + 1;
+    vector<char> source(limit);
+    vector<char> expected(limit);
+    vector<char> actual(limit);
+    unsigned char next = 0;
+
+    for (size_t step = 0; !input.isAtEnd(); ++step) {
+        auto operation = input.next() % OPERATION_COUNT;
+        auto count = input.nextCount(capacity);
+        size_t want = 0;
+        size_t got = 0;
+        switch (operation) {
+        case WRITE:
+            // Number the bytes, so that any reordering shows.
+            for (size_t i = 0; i < count; ++i) {
+                source[i] = static_cast<char>(next++);
+            }
+            want = model.write(source.data(), count);
+            got = ring.write(source.data(), count);
+            break;
+        case READ:
+            want = model.read(expected.data(), count);
+            got = ring.read(actual.data(), count);
+            break;
+        case PEEK_AT: {
+            auto where = input.nextCount(capacity);
+            want = model.peekAt(expected.data(), count, where);
+            got = ring.peekAt(actual.data(), count, where);
+            if (got == UNSUPPORTED) {
+                continue;
+            }
+            break;
+        }
+        case DISCARD:
+            want = model.discard(count);
+            got = ring.discard(count);
+            break;
+        default:
+            model.clear();
+            ring.clear();
+            break;
+        }
+
+        auto name = OPERATION_NAMES[operation];
+        if (got != want) {
+            return mismatch(variant, step, name,
+                            "returned " + to_string(got) + " instead of " +
+                                to_string(want));
+        }
+        if ((operation == READ || operation == PEEK_AT) &&
+            !equal(expected.begin(), expected.begin() + want,
+                   actual.begin())) {
+            return mismatch(variant, step, name, "copied the wrong bytes");
+        }
+        if (ring.size() != model.size()) {
+            return mismatch(variant, step, name,
+                            "left " + to_string(ring.size()) +
+                                " readable bytes instead of " +
+                                to_string(model.size()));
+        }
+    }
+
+    // Whatever is left must be the same too.
+    auto want = model.read(expected.data(), limit);
+    auto got = ring.read(actual.data(), limit);
+    if (got != want ||
+        !equal(expected.begin(), expected.begin() + want, actual.begin())) {
+        return string(variant) + ": the remaining bytes differ";
+    }
+    return string();
+}
+
+string checkRingBuffer(size_t capacity, const uint8_t *data, size_t size) {
+    vector<char> buffer(capacity);
+    RingBuffer ring(buffer.data(), buffer.size());
+    return check("RingBuffer", ByteAdapter<RingBuffer>(ring), capacity, data,
+                 size);
+}
+
+string checkMirroredRingBuffer(size_t, const uint8_t *data, size_t size) {
+    // The capacity is a whole number of pages, whatever the input asks for.
+    MirroredMemory memory(1);
+    if (!memory.isValid()) {
+        return string();
+    }
+    RingBuffer ring(memory.getBuffer(), memory.getSize(), true);
+    return check("mirrored RingBuffer", ByteAdapter<RingBuffer>(ring),
+                 memory.getSize(), data, size);
+}
+
+string checkPowerOfTwoRingBuffer(size_t capacity, const uint8_t *data,
+                                 size_t size) {
+    vector<char> buffer(capacity);
+    PowerOfTwoRingBuffer ring(buffer.data(), buffer.size());
+    return check("PowerOfTwoRingBuffer",
+                 ByteAdapter<PowerOfTwoRingBuffer>(ring), capacity, data,
+                 size);
+}
+
+string checkSpscRingBuffer(size_t capacity, const uint8_t *data,
+                           size_t size) {
+    vector<char> buffer(capacity);
+    SpscRingBuffer ring(buffer.data(), buffer.size());
+    return check("SpscRingBuffer", ByteAdapter<SpscRingBuffer>(ring),
+                 capacity, data, size);
+}
+
+string checkSharedRingBuffer(size_t capacity, const uint8_t *data,
+                             size_t size) {
+    // The control block needs 128-byte alignment, as a page has.
+    const size_t ALIGNMENT = 128;
+    auto memorySize = SharedRingBuffer::getMemorySize(capacity);
+    vector<char> buffer(memorySize + ALIGNMENT);
+    auto address = reinterpret_cast<uintptr_t>(buffer.data());
+    auto memory = buffer.data() + (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+    SharedRingBuffer::initialize(memory, memorySize);
+    SharedRingBuffer ring(memory, memorySize);
+    return check("SharedRingBuffer", SharedAdapter(ring), capacity, data,
+                 size);
+}
+
+string checkGrowableRingBuffer(size_t capacity, const uint8_t *data,
+                               size_t size) {
+    // Start small, so that writes grow the buffer up to the capacity.
+    GrowableRingBuffer ring((capacity + 3) / 4, capacity);
+    return check("GrowableRingBuffer", GrowableAdapter(ring), capacity, data,
+                 size);
+}
+
+string checkTypedRingBuffer(size_t, const uint8_t *data, size_t size) {
+    // The capacity is part of the type.
+    const size_t CAPACITY = 64;
+    char buffer[CAPACITY];
+    TypedRingBuffer<char, CAPACITY> ring(buffer);
+    return check("TypedRingBuffer", TypedAdapter<CAPACITY>(ring), CAPACITY,
+                 data, size);
+}
+
+/**
+ * Runs the write and read operations against an MpmcRingBuffer, with one
+ * message per operation, and a model of messages.
+ */
+string checkMpmcRingBuffer(size_t capacity, const uint8_t *data,
+                           size_t size) {
+    const size_t SLOT_SIZE = 16;
+    auto bufferSize = MpmcRingBuffer::getBufferSize(capacity, SLOT_SIZE);
+    vector<size_t> buffer((bufferSize + sizeof(size_t) - 1) / sizeof(size_t));
+    MpmcRingBuffer ring(buffer.data(), bufferSize, SLOT_SIZE);
+    deque<string> model;
+    Input input(data, size);
+    unsigned char next = 0;
+
+    for (size_t step = 0; !input.isAtEnd(); ++step) {
+        auto operation = input.next() % OPERATION_COUNT;
+        auto count = input.next() % (SLOT_SIZE + 1);
+        if (operation == WRITE) {
+            string message(count, '\0');
+            for (auto &byte : message) {
+                byte = static_cast<char>(next++);
+            }
+            auto want = model.size() < ring.getSlotCount();
+            if (want) {
+                model.push_back(message);
+            }
+            if (ring.tryWrite(message.data(), message.size()) != want) {
+                return mismatch("MpmcRingBuffer", step, "tryWrite",
+                                want ? "failed" : "succeeded when full");
+            }
+        } else if (operation == READ) {
+            char message[SLOT_SIZE];
+            size_t got = 0;
+            auto read = ring.tryRead(message, sizeof(message), got);
+            if (read != !model.empty()) {
+                return mismatch("MpmcRingBuffer", step, "tryRead",
+                                read ? "succeeded when empty" : "failed");
+            }
+            if (read) {
+                if (string(message, got) != model.front()) {
+                    return mismatch("MpmcRingBuffer", step, "tryRead",
+                                    "returned the wrong message");
+                }
+                model.pop_front();
+            }
+        }
+        if (ring.getReadableCount() != model.size()) {
+            return mismatch("MpmcRingBuffer", step, OPERATION_NAMES[operation],
+                            "left the wrong number of messages");
+        }
+    }
+    return string();
+}
+
+} // namespace
+
+std::string hdc::ringbuffer::differential::run(const std::uint8_t *data,
+                                               std::size_t size) {
+    if (size == 0) {
+        return string();
+    }
+    // Small capacities, so that short inputs fill, wrap and empty them.
+    auto capacity = static_cast<size_t>(1) << (data[0] % 8);
+    ++data;
+    --size;
+
+    string (*const checks[])(size_t, const uint8_t *, size_t) = {
+        checkRingBuffer,           checkMirroredRingBuffer,
+        checkPowerOfTwoRingBuffer, checkSpscRingBuffer,
+        checkSharedRingBuffer,     checkGrowableRingBuffer,
+        checkTypedRingBuffer,      checkMpmcRingBuffer};
+    for (auto check : checks) {
+        auto result = check(capacity, data, size);
+        if (!result.empty()) {
+            return result;
+        }
+    }
+    return string();
+}
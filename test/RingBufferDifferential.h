@@ -0,0 +1,75 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file
+ * Declares the differential harness, which checks every ring buffer variant
+ * against a model.
+ */
+
+#ifndef _HDC_RINGBUFFERDIFFERENTIAL_H
+#define _HDC_RINGBUFFERDIFFERENTIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace hdc {
+namespace ringbuffer {
+namespace differential {
+
+/**
+ * Runs a sequence of operations decoded from arbitrary bytes against every
+ * ring buffer variant and compares each one with a reference model, a
+ * <tt>std::deque<char></tt> with a capacity.
+ *
+ * The first byte selects the capacity. Each pair of bytes after it is an
+ * operation: writeBytes(), readBytes(), peekBytesAt(), discardBytes() or
+ * clear(), followed by a count scaled to the capacity. peekBytesAt() takes a
+ * third byte for the offset. After each operation, the returned count, the
+ * bytes copied and the number of readable bytes must match the model, and at
+ * the end, so must the remaining contents.
+ *
+ * The byte variants are RingBuffer, on plain and on mirrored memory,
+ * PowerOfTwoRingBuffer, SpscRingBuffer, SharedRingBuffer, GrowableRingBuffer
+ * and TypedRingBuffer. MpmcRingBuffer, which moves whole messages, runs the
+ * write and read operations against a model of messages.
+ *
+ * @param[in] data
+ * The bytes to decode.
+ *
+ * @param[in] size
+ * The number of bytes.
+ *
+ * @return
+ * An empty string if every variant matched the model, and otherwise a
+ * description of the first mismatch.
+ */
+std::string run(const std::uint8_t *data, std::size_t size);
+
+} // namespace differential
+} // namespace ringbuffer
+} // namespace hdc
+
+#endif // _HDC_RINGBUFFERDIFFERENTIAL_H
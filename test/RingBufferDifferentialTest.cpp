@@ -0,0 +1,61 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "RingBufferDifferential.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+TEST(RingBufferDifferentialTest, EmptyInputMatches) {
+    ASSERT_EQ(differential::run(nullptr, 0), "");
+    const uint8_t capacityOnly[] = {3};
+    ASSERT_EQ(differential::run(capacityOnly, sizeof(capacityOnly)), "");
+}
+
+TEST(RingBufferDifferentialTest, FillAndDrainMatches) {
+    // Capacity 16: write 25, peek 7 at 3, read 4, write 12, discard 25,
+    // clear.
+    const uint8_t input[] = {4, 0, 255, 2, 80, 40, 1, 50, 0, 128, 3, 255, 4, 0};
+    ASSERT_EQ(differential::run(input, sizeof(input)), "");
+}
+
+TEST(RingBufferDifferentialTest, RandomSequencesMatch) {
+    // A fixed seed keeps failures reproducible.
+    mt19937 random(20251014);
+    vector<uint8_t> input;
+    for (int i = 0; i < 2000; ++i) {
+        input.resize(1 + random() % 512);
+        for (auto &byte : input) {
+            byte = static_cast<uint8_t>(random());
+        }
+        ASSERT_EQ(differential::run(input.data(), input.size()), "")
+            << "input " << i;
+    }
+}
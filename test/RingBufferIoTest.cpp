@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "RingBufferIo.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class RingBufferIoTest : public testing::Test {
+protected:
+    RingBufferIoTest() : m_ring_buffer(m_buffer.data(), BUFFER_SIZE) {
+        iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+        // Move the read and write locations so that the next transfer wraps
+        // around the end of the buffer.
+        m_ring_buffer.writeBytes(m_write_buffer.data(), WRAP_OFFSET);
+        m_ring_buffer.discardBytes(WRAP_OFFSET);
+    }
+
+    ~RingBufferIoTest() override {
+        for (auto fd : m_fds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+    }
+
+    static const size_t BUFFER_SIZE = 96;
+    static const size_t WRAP_OFFSET = 60;
+    static const size_t TRANSFER_SIZE = 80;
+
+    array<int, 2> m_fds = {{-1, -1}};
+    array<int8_t, BUFFER_SIZE> m_read_buffer;
+    array<int8_t, BUFFER_SIZE> m_write_buffer;
+    array<int8_t, BUFFER_SIZE> m_buffer;
+    RingBuffer m_ring_buffer;
+};
+
+const size_t RingBufferIoTest::BUFFER_SIZE;
+const size_t RingBufferIoTest::WRAP_OFFSET;
+const size_t RingBufferIoTest::TRANSFER_SIZE;
+
+TEST_F(RingBufferIoTest, TestReadFromFd) {
+    ASSERT_EQ(pipe(m_fds.data()), 0);
+    ASSERT_EQ(write(m_fds[1], m_write_buffer.data(), TRANSFER_SIZE),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+
+    // Read in one call even though the free space wraps around.
+    ASSERT_EQ(readFromFd(m_ring_buffer, m_fds[0], BUFFER_SIZE),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_EQ(m_ring_buffer.getReadableByteCount(), TRANSFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), BUFFER_SIZE),
+              TRANSFER_SIZE);
+    ASSERT_TRUE(equal(m_read_buffer.begin(),
+                      m_read_buffer.begin() + TRANSFER_SIZE,
+                      m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferIoTest, TestReadFromFdLimitsCount) {
+    ASSERT_EQ(pipe(m_fds.data()), 0);
+    ASSERT_EQ(write(m_fds[1], m_write_buffer.data(), TRANSFER_SIZE),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_EQ(readFromFd(m_ring_buffer, m_fds[0], 50), 50);
+    ASSERT_EQ(m_ring_buffer.getReadableByteCount(), 50u);
+}
+
+TEST_F(RingBufferIoTest, TestWriteToFd) {
+    ASSERT_EQ(pipe(m_fds.data()), 0);
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), TRANSFER_SIZE),
+              TRANSFER_SIZE);
+
+    // Write in one call even though the data wraps around.
+    ASSERT_EQ(writeToFd(m_ring_buffer, m_fds[1], BUFFER_SIZE),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+    ASSERT_EQ(read(m_fds[0], m_read_buffer.data(), BUFFER_SIZE),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_TRUE(equal(m_read_buffer.begin(),
+                      m_read_buffer.begin() + TRANSFER_SIZE,
+                      m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferIoTest, TestSendReceive) {
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds.data()), 0);
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), TRANSFER_SIZE),
+              TRANSFER_SIZE);
+
+    ASSERT_EQ(sendToSocket(m_ring_buffer, m_fds[0], BUFFER_SIZE, 0),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+
+    ASSERT_EQ(receiveFromSocket(m_ring_buffer, m_fds[1], BUFFER_SIZE, 0),
+              static_cast<ssize_t>(TRANSFER_SIZE));
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), BUFFER_SIZE),
+              TRANSFER_SIZE);
+    ASSERT_TRUE(equal(m_read_buffer.begin(),
+                      m_read_buffer.begin() + TRANSFER_SIZE,
+                      m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferIoTest, FullOrEmptyTransfersNothing) {
+    ASSERT_EQ(pipe(m_fds.data()), 0);
+    ASSERT_EQ(writeToFd(m_ring_buffer, m_fds[1], BUFFER_SIZE), 0);
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), BUFFER_SIZE),
+              BUFFER_SIZE);
+    ASSERT_EQ(readFromFd(m_ring_buffer, m_fds[0], BUFFER_SIZE), 0);
+}
+
+TEST_F(RingBufferIoTest, ErrorLeavesRingBufferUnchanged) {
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), TRANSFER_SIZE),
+              TRANSFER_SIZE);
+    ASSERT_EQ(readFromFd(m_ring_buffer, -1, BUFFER_SIZE), -1);
+    ASSERT_EQ(writeToFd(m_ring_buffer, -1, BUFFER_SIZE), -1);
+    ASSERT_EQ(m_ring_buffer.getReadableByteCount(), TRANSFER_SIZE);
+}
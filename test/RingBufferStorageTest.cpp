@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "RingBuffer.h"
+#include "RingBufferStorage.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+const size_t HUGE_PAGE_SIZE = size_t(1) << 21;
+
+} // namespace
+
+TEST(RingBufferStorageTest, RoundsUpToBasePage) {
+    RingBufferStorage storage(1);
+    ASSERT_TRUE(storage.isValid());
+    ASSERT_EQ(storage.getSize(), RingBufferStorage::getBasePageSize());
+    ASSERT_EQ(storage.getPageSize(), RingBufferStorage::getBasePageSize());
+    ASSERT_FALSE(storage.isLocked());
+}
+
+TEST(RingBufferStorageTest, ZeroSizeIsInvalid) {
+    RingBufferStorage storage(0);
+    ASSERT_FALSE(storage.isValid());
+    ASSERT_EQ(storage.getBuffer(), nullptr);
+    ASSERT_EQ(storage.getSize(), 0u);
+    ASSERT_EQ(storage.getPageSize(), 0u);
+}
+
+TEST(RingBufferStorageTest, HugePagesRoundUpAndAlign) {
+    // Succeeds whether or not the system has huge pages to spare.
+    RingBufferStorage storage(1, RingBufferStorage::HUGE_PAGES);
+    ASSERT_TRUE(storage.isValid());
+    ASSERT_EQ(storage.getSize(), HUGE_PAGE_SIZE);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(storage.getBuffer()) %
+                  HUGE_PAGE_SIZE,
+              0u);
+    auto page_size = storage.getPageSize();
+    ASSERT_TRUE(page_size == HUGE_PAGE_SIZE ||
+                page_size == RingBufferStorage::getBasePageSize());
+}
+
+TEST(RingBufferStorageTest, PrefaultAndLock) {
+    RingBufferStorage storage(64 * 1024, RingBufferStorage::PREFAULT |
+                                             RingBufferStorage::LOCK);
+    ASSERT_TRUE(storage.isValid());
+    auto buffer = static_cast<char *>(storage.getBuffer());
+    for (size_t i = 0; i < storage.getSize(); ++i) {
+        ASSERT_EQ(buffer[i], 0);
+    }
+}
+
+#if defined(__linux__)
+TEST(RingBufferStorageTest, BindsToNode) {
+    RingBufferStorage storage(64 * 1024, RingBufferStorage::PREFAULT, 0);
+    ASSERT_TRUE(storage.isValid());
+
+    RingBufferStorage missing(64 * 1024, RingBufferStorage::NONE, 4095);
+    ASSERT_FALSE(missing.isValid());
+}
+
+TEST(RingBufferStorageTest, BindsHugePagesToNode) {
+    // Whether or not the huge page pool has pages on node 0, the memory ends
+    // up valid and touchable.
+    RingBufferStorage storage(1, RingBufferStorage::HUGE_PAGES |
+                                     RingBufferStorage::PREFAULT,
+                              0);
+    ASSERT_TRUE(storage.isValid());
+
+    RingBufferStorage missing(1, RingBufferStorage::HUGE_PAGES, 4095);
+    ASSERT_FALSE(missing.isValid());
+}
+#endif
+
+TEST(RingBufferStorageTest, RejectsNegativeNode) {
+    RingBufferStorage storage(64 * 1024, RingBufferStorage::NONE,
+                              RingBufferStorage::ANY_NODE - 1);
+    ASSERT_FALSE(storage.isValid());
+}
+
+TEST(RingBufferStorageTest, MoveTransfersMapping) {
+    RingBufferStorage storage(1, RingBufferStorage::LOCK);
+    ASSERT_TRUE(storage.isValid());
+    auto buffer = storage.getBuffer();
+    auto locked = storage.isLocked();
+
+    RingBufferStorage other(move(storage));
+    ASSERT_FALSE(storage.isValid());
+    ASSERT_FALSE(storage.isLocked());
+    ASSERT_EQ(other.getBuffer(), buffer);
+    ASSERT_EQ(other.isLocked(), locked);
+
+    storage = move(other);
+    ASSERT_TRUE(storage.isValid());
+    ASSERT_FALSE(other.isValid());
+    ASSERT_EQ(storage.getBuffer(), buffer);
+}
+
+TEST(RingBufferStorageTest, BacksRingBuffer) {
+    RingBufferStorage storage(1, RingBufferStorage::HUGE_PAGES |
+                                     RingBufferStorage::PREFAULT);
+    ASSERT_TRUE(storage.isValid());
+    RingBuffer ring_buffer(storage.getBuffer(), storage.getSize());
+
+    vector<char> write_buffer(storage.getSize());
+    vector<char> read_buffer(storage.getSize());
+    iota(write_buffer.begin(), write_buffer.end(), 0);
+    ASSERT_EQ(ring_buffer.writeBytes(write_buffer.data(), write_buffer.size()),
+              write_buffer.size());
+    ASSERT_TRUE(ring_buffer.isFull());
+    ASSERT_EQ(ring_buffer.readBytes(read_buffer.data(), read_buffer.size()),
+              read_buffer.size());
+    ASSERT_EQ(read_buffer, write_buffer);
+}
@@ -29,11 +29,27 @@ SOFTWARE.
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <numeric>
+#include <vector>
 
 using namespace std;
 using namespace hdc::ringbuffer;
 
+namespace {
+
+size_t copy_count = 0;
+
+/**
+ * Counts the copies made through it.
+ */
+void countingCopy(void *destination, const void *source, size_t count) {
+    ++copy_count;
+    memcpy(destination, source, count);
+}
+
+} // namespace
+
 class RingBufferTest : public testing::Test {
 protected:
     RingBufferTest() : m_ring_buffer(m_buffer.data(), BUFFER_SIZE) {}
@@ -364,4 +380,472 @@ TEST_F(RingBufferTest, TestCumulativeReadWrite) {
         testRead(i, i);
         checkState(true, false, 0, BUFFER_SIZE);
     }
-}
\ No newline at end of file
+}
+
+TEST_F(RingBufferTest, TestReserveCommit) {
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Move the read and write locations to i, with i bytes still
+            // readable, so that the free space wraps around.
+            m_ring_buffer.clear();
+            testWrite(i, i);
+            testDiscard(i, i);
+            testWrite(i / 2, i / 2);
+            testDiscard(i / 2, i / 2);
+
+            // Reserve up to j bytes and fill them in place.
+            auto expected_reserve = min(j, BUFFER_SIZE);
+            auto spans = m_ring_buffer.reserveWrite(j);
+            ASSERT_EQ(spans.size(), expected_reserve);
+            iota(spans.first.data, spans.first.data + spans.first.size, 0);
+            iota(spans.second.data, spans.second.data + spans.second.size,
+                 static_cast<char>(spans.first.size));
+            checkState(true, false, 0, BUFFER_SIZE);
+
+            // Commit the bytes and read them back.
+            m_ring_buffer.commitWrite(expected_reserve);
+            checkState(expected_reserve == ZERO_SIZE,
+                       expected_reserve == BUFFER_SIZE, expected_reserve,
+                       BUFFER_SIZE - expected_reserve);
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(),
+                 m_check_buffer.begin() + expected_reserve, 0);
+            fill(m_check_buffer.begin() + expected_reserve,
+                 m_check_buffer.end(), -1);
+            testRead(j, expected_reserve);
+            checkState(true, false, 0, BUFFER_SIZE);
+        }
+    }
+}
+
+TEST_F(RingBufferTest, ReserveFullReturnsEmpty) {
+    testWrite(BUFFER_SIZE, BUFFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.reserveWrite(BUFFER_SIZE).size(), ZERO_SIZE);
+    m_ring_buffer.commitWrite(0);
+    checkState(false, true, BUFFER_SIZE, 0);
+}
+
+TEST_F(RingBufferTest, TestReadableSpansConsume) {
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j <= BUFFER_SIZE; ++j) {
+            // Move the read and write locations to i, then write j bytes so
+            // that the data wraps around.
+            m_ring_buffer.clear();
+            testWrite(i, i);
+            testDiscard(i, i);
+            iota(m_write_buffer.begin(), m_write_buffer.begin() + j, 0);
+            testWrite(j, j);
+
+            // Inspect the data in place.
+            auto spans = m_ring_buffer.readableSpans();
+            ASSERT_EQ(spans.size(), j);
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            auto end = copy(spans.first.data,
+                            spans.first.data + spans.first.size,
+                            m_read_buffer.begin());
+            copy(spans.second.data, spans.second.data + spans.second.size,
+                 end);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + j, 0);
+            fill(m_check_buffer.begin() + j, m_check_buffer.end(), -1);
+            ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                              m_check_buffer.begin(), m_check_buffer.end()));
+            checkState(j == ZERO_SIZE, j == BUFFER_SIZE, j, BUFFER_SIZE - j);
+
+            // Consume the first half without copying it out.
+            m_ring_buffer.consume(j / 2);
+            checkState(j - j / 2 == ZERO_SIZE, false, j - j / 2,
+                       BUFFER_SIZE - j + j / 2);
+            spans = m_ring_buffer.readableSpans();
+            ASSERT_EQ(spans.size(), j - j / 2);
+            if (spans.size() > 0) {
+                ASSERT_EQ(spans.first.data[0], static_cast<char>(j / 2));
+            }
+        }
+    }
+}
+
+TEST_F(RingBufferTest, TestDiscardAcrossWrap) {
+    for (auto i = ZERO_SIZE + 2; i < BUFFER_SIZE; ++i) {
+        // Move the read location to i and the write location to i - 1 so
+        // that the data wraps around, then discard past the wrap.
+        m_ring_buffer.clear();
+        testWrite(BUFFER_SIZE, BUFFER_SIZE);
+        testDiscard(i, i);
+        testWrite(i - 1, i - 1);
+        testDiscard(BUFFER_SIZE - i + 1, BUFFER_SIZE - i + 1);
+        checkState(i == 2, false, i - 2, BUFFER_SIZE - i + 2);
+    }
+}
+
+TEST_F(RingBufferTest, TestBatch) {
+    const size_t sizes[] = {5, 17, 40, 30, 10};
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        // Move the read and write locations to i so that the batch wraps
+        // around.
+        m_ring_buffer.clear();
+        testWrite(i, i);
+        testDiscard(i, i);
+
+        // All but the last message fit.
+        ConstSpan messages[5];
+        auto source = reinterpret_cast<const char *>(m_write_buffer.data());
+        for (size_t k = 0; k < 5; ++k) {
+            messages[k].data = source;
+            messages[k].size = sizes[k];
+            source += sizes[k];
+        }
+        ASSERT_EQ(m_ring_buffer.writeBatch(messages, 5), 4u);
+        checkState(false, false, 92, BUFFER_SIZE - 92);
+
+        // All but the last destination fill up.
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+        Span destinations[5];
+        auto destination = reinterpret_cast<char *>(m_read_buffer.data());
+        for (size_t k = 0; k < 5; ++k) {
+            destinations[k].data = destination;
+            destinations[k].size = k == 4 ? 3 : sizes[k];
+            destination += sizes[k];
+        }
+        ASSERT_EQ(m_ring_buffer.readBatch(destinations, 5), 4u);
+        iota(m_check_buffer.begin(), m_check_buffer.begin() + 92, 0);
+        fill(m_check_buffer.begin() + 92, m_check_buffer.end(), -1);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+        checkState(true, false, 0, BUFFER_SIZE);
+
+        // Nothing to do.
+        ASSERT_EQ(m_ring_buffer.writeBatch(messages, 0), 0u);
+        ASSERT_EQ(m_ring_buffer.readBatch(destinations, 1), 0u);
+    }
+}
+
+TEST_F(RingBufferTest, TestOverwrite) {
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Start with i bytes, then overwrite j more, which drops
+            // whatever does not fit from the front.
+            m_ring_buffer.clear();
+            testWrite(i, i);
+            auto before = m_ring_buffer.getDroppedByteCount();
+            auto expected_drop = i + j > BUFFER_SIZE ? i + j - BUFFER_SIZE : 0;
+            ASSERT_EQ(m_ring_buffer.overwriteBytes(m_write_buffer.data(), j),
+                      expected_drop);
+            ASSERT_EQ(m_ring_buffer.getDroppedByteCount() - before,
+                      expected_drop);
+
+            // The ring buffer holds the newest bytes: the tail of the first
+            // write followed by the tail of the second.
+            auto kept = min(i + j, BUFFER_SIZE);
+            auto kept_second = min(j, BUFFER_SIZE);
+            auto kept_first = kept - kept_second;
+            checkState(kept == ZERO_SIZE, kept == BUFFER_SIZE, kept,
+                       BUFFER_SIZE - kept);
+            fill(m_check_buffer.begin(), m_check_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + kept_first,
+                 static_cast<int8_t>(i - kept_first));
+            iota(m_check_buffer.begin() + kept_first,
+                 m_check_buffer.begin() + kept,
+                 static_cast<int8_t>(j - kept_second));
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            testRead(kept, kept);
+        }
+    }
+}
+
+TEST_F(RingBufferTest, TestCopyFunction) {
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    ASSERT_EQ(m_ring_buffer.getCopyFunction(), nullptr);
+    m_ring_buffer.setCopyFunction(countingCopy, 10);
+    ASSERT_EQ(m_ring_buffer.getCopyFunction(), countingCopy);
+
+    copy_count = 0;
+    testWrite(BUFFER_SIZE, BUFFER_SIZE);
+    ASSERT_EQ(copy_count, 1u);
+
+    // Leave 12 free bytes before the end of the buffer and 10 after the wrap,
+    // so that a 20-byte write is copied as 12 bytes through the copy function,
+    // then 8 bytes with memcpy().
+    testDiscard(BUFFER_SIZE - 12, BUFFER_SIZE - 12);
+    testWrite(BUFFER_SIZE - 12, BUFFER_SIZE - 12);
+    testDiscard(22, 22);
+    copy_count = 0;
+    testWrite(20, 20);
+    ASSERT_EQ(copy_count, 1u);
+    testDiscard(BUFFER_SIZE - 22, BUFFER_SIZE - 22);
+
+    fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+    iota(m_check_buffer.begin(), m_check_buffer.begin() + 20, 0);
+    fill(m_check_buffer.begin() + 20, m_check_buffer.end(), -1);
+    copy_count = 0;
+    testPeek(20, 20);
+    ASSERT_EQ(copy_count, 1u);
+
+    m_ring_buffer.setCopyFunction(nullptr);
+    copy_count = 0;
+    testRead(20, 20);
+    ASSERT_EQ(copy_count, 0u);
+    checkState(true, false, ZERO_SIZE, BUFFER_SIZE);
+}
+
+TEST_F(RingBufferTest, TestLinearize) {
+    vector<int8_t> sequence(2 * BUFFER_SIZE);
+    iota(sequence.begin(), sequence.end(), 0);
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE; ++i) {
+        for (auto n = ZERO_SIZE; n <= BUFFER_SIZE; ++n) {
+            // Leave n bytes that end at index i, so that every split of the
+            // data around the wrap comes up.
+            m_ring_buffer.clear();
+            ASSERT_EQ(m_ring_buffer.writeBytes(sequence.data(), BUFFER_SIZE),
+                      BUFFER_SIZE);
+            testDiscard(i, i);
+            ASSERT_EQ(
+                m_ring_buffer.writeBytes(sequence.data() + BUFFER_SIZE, i), i);
+            testDiscard(BUFFER_SIZE - n, BUFFER_SIZE - n);
+            auto expected = sequence.begin() + BUFFER_SIZE + i - n;
+
+            auto spans = m_ring_buffer.readableSpans();
+            ASSERT_EQ(m_ring_buffer.isContiguous(), spans.second.size == 0);
+
+            auto span = m_ring_buffer.linearize();
+            ASSERT_TRUE(m_ring_buffer.isContiguous());
+            ASSERT_EQ(span.size, n);
+            ASSERT_TRUE(equal(span.data, span.data + n, expected));
+            spans = m_ring_buffer.readableSpans();
+            ASSERT_EQ(spans.first.size, n);
+            ASSERT_EQ(spans.second.size, 0u);
+            if (n != 0) {
+                ASSERT_EQ(spans.first.data, span.data);
+            }
+            checkState(n == 0, n == BUFFER_SIZE, n, BUFFER_SIZE - n);
+
+            // The free space is contiguous too.
+            auto free_spans = m_ring_buffer.reserveWrite(BUFFER_SIZE);
+            ASSERT_EQ(free_spans.first.size, BUFFER_SIZE - n);
+            ASSERT_EQ(free_spans.second.size, 0u);
+        }
+    }
+}
+
+TEST_F(RingBufferTest, TestResize) {
+    vector<int8_t> sequence(2 * BUFFER_SIZE);
+    iota(sequence.begin(), sequence.end(), 0);
+    vector<int8_t> larger(BUFFER_SIZE + 17);
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE; i += 7) {
+        for (auto n = ZERO_SIZE; n <= BUFFER_SIZE; ++n) {
+            // Leave n bytes that end at index i, as in TestLinearize, then
+            // move them to a larger buffer.
+            m_ring_buffer.clear();
+            ASSERT_EQ(m_ring_buffer.writeBytes(sequence.data(), BUFFER_SIZE),
+                      BUFFER_SIZE);
+            testDiscard(i, i);
+            ASSERT_EQ(
+                m_ring_buffer.writeBytes(sequence.data() + BUFFER_SIZE, i), i);
+            testDiscard(BUFFER_SIZE - n, BUFFER_SIZE - n);
+            auto expected = sequence.begin() + BUFFER_SIZE + i - n;
+
+            RingBuffer ring_buffer = m_ring_buffer;
+            ring_buffer.resize(larger.data(), larger.size());
+            ASSERT_EQ(ring_buffer.getReadableByteCount(), n);
+            ASSERT_EQ(ring_buffer.getWritableByteCount(), larger.size() - n);
+            ASSERT_TRUE(ring_buffer.isContiguous());
+            ASSERT_TRUE(equal(larger.begin(), larger.begin() + n, expected));
+
+            // The new buffer is a ring buffer like any other.
+            ASSERT_EQ(ring_buffer.writeBytes(sequence.data(), larger.size()),
+                      larger.size() - n);
+            ASSERT_TRUE(ring_buffer.isFull());
+            vector<int8_t> read(larger.size());
+            ASSERT_EQ(ring_buffer.readBytes(read.data(), read.size()),
+                      read.size());
+            ASSERT_TRUE(equal(read.begin(), read.begin() + n, expected));
+            ASSERT_TRUE(
+                equal(read.begin() + n, read.end(), sequence.begin()));
+        }
+    }
+
+    // Shrinking works as long as the readable bytes fit, and a full ring
+    // buffer stays full.
+    m_ring_buffer.clear();
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    testWrite(10, 10);
+    vector<int8_t> exact(10);
+    m_ring_buffer.resize(exact.data(), exact.size());
+    ASSERT_TRUE(m_ring_buffer.isFull());
+    ASSERT_TRUE(equal(exact.begin(), exact.end(), m_write_buffer.begin()));
+    m_ring_buffer.clear();
+    m_ring_buffer.resize(larger.data(), larger.size());
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST_F(RingBufferTest, TestRestore) {
+    for (auto offset = ZERO_SIZE; offset < BUFFER_SIZE; offset += 5) {
+        for (auto n = ZERO_SIZE; n <= BUFFER_SIZE; ++n) {
+            // The bytes are in the buffer already, starting at the offset.
+            for (auto i = ZERO_SIZE; i < BUFFER_SIZE; ++i) {
+                m_buffer[(offset + i) % BUFFER_SIZE] = static_cast<int8_t>(i);
+            }
+            m_ring_buffer.restore(offset, n);
+            checkState(n == 0, n == BUFFER_SIZE, n, BUFFER_SIZE - n);
+            if (n != 0) {
+                ASSERT_EQ(m_ring_buffer.readableSpans().first.data,
+                          reinterpret_cast<const char *>(m_buffer.data()) +
+                              offset);
+            }
+
+            // The free space follows the restored bytes.
+            array<int8_t, BUFFER_SIZE> more;
+            iota(more.begin(), more.end(), static_cast<int8_t>(n));
+            ASSERT_EQ(m_ring_buffer.writeBytes(more.data(), more.size()),
+                      BUFFER_SIZE - n);
+            array<int8_t, BUFFER_SIZE> read;
+            ASSERT_EQ(m_ring_buffer.readBytes(read.data(), read.size()),
+                      BUFFER_SIZE);
+            for (auto i = ZERO_SIZE; i < BUFFER_SIZE; ++i) {
+                ASSERT_EQ(read[i], static_cast<int8_t>(i));
+            }
+        }
+    }
+}
+
+TEST_F(RingBufferTest, TestCrc32c) {
+    const size_t filler = 10;
+    const size_t size = BUFFER_SIZE - filler;
+    vector<int8_t> sequence(2 * BUFFER_SIZE);
+    iota(sequence.begin(), sequence.end(), 0);
+    vector<int8_t> read_buffer(size);
+    for (auto i = ZERO_SIZE; i + filler <= BUFFER_SIZE; i += 5) {
+        // Leave filler bytes at index i, so that the free space and then the
+        // data wrap around the end of the buffer.
+        m_ring_buffer.clear();
+        ASSERT_EQ(m_ring_buffer.writeBytes(sequence.data(), i + filler),
+                  i + filler);
+        testDiscard(i, i);
+
+        uint32_t write_crc = 0;
+        auto data = sequence.data() + i;
+        ASSERT_EQ(m_ring_buffer.writeBytes(data, 30, write_crc), 30u);
+        ASSERT_EQ(m_ring_buffer.writeBytes(data + 30, BUFFER_SIZE, write_crc),
+                  size - 30);
+        ASSERT_EQ(write_crc, crc32c(data, size));
+        testDiscard(filler, filler);
+
+        uint32_t peek_crc = 0;
+        ASSERT_EQ(m_ring_buffer.peekBytes(read_buffer.data(), BUFFER_SIZE,
+                                          peek_crc),
+                  size);
+        ASSERT_EQ(peek_crc, write_crc);
+
+        uint32_t read_crc = 0;
+        ASSERT_EQ(m_ring_buffer.readBytes(read_buffer.data(), 30, read_crc),
+                  30u);
+        ASSERT_EQ(m_ring_buffer.readBytes(read_buffer.data() + 30,
+                                          BUFFER_SIZE, read_crc),
+                  size - 30);
+        ASSERT_EQ(read_crc, write_crc);
+        ASSERT_TRUE(equal(read_buffer.begin(), read_buffer.end(), data));
+        ASSERT_TRUE(m_ring_buffer.isEmpty());
+    }
+}
+
+TEST_F(RingBufferTest, TestStats) {
+    // Without HDC_RINGBUFFER_STATS, every statistic stays zero.
+    auto expected = [](uint64_t value) {
+        return RingBufferStats::ENABLED ? value : 0;
+    };
+
+    testWrite(60, 60);
+    testWrite(60, BUFFER_SIZE - 60);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 0), 0u);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 50), 50u);
+    testDiscard(100, BUFFER_SIZE - 50);
+    ASSERT_EQ(m_ring_buffer.peekBytes(m_read_buffer.data(), 1), 0u);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 1), 0u);
+
+    auto stats = m_ring_buffer.getStats();
+    ASSERT_EQ(stats.bytesWritten, expected(BUFFER_SIZE));
+    ASSERT_EQ(stats.bytesRead, expected(BUFFER_SIZE));
+    ASSERT_EQ(stats.shortWrites, expected(1));
+    ASSERT_EQ(stats.shortReads, expected(2));
+    ASSERT_EQ(stats.fullCount, expected(1));
+    ASSERT_EQ(stats.emptyCount, expected(1));
+    ASSERT_EQ(stats.wrapCount, expected(1));
+    ASSERT_EQ(stats.peakReadableBytes, expected(BUFFER_SIZE));
+}
+
+TEST_F(RingBufferTest, TestFindByte) {
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE; ++i) {
+        // Move the read location to i and fill the ring buffer so that the
+        // data wraps around after BUFFER_SIZE - i bytes.
+        m_ring_buffer.clear();
+        testWrite(BUFFER_SIZE, BUFFER_SIZE);
+        testDiscard(i, i);
+        testWrite(i, i);
+
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE; ++j) {
+            // Byte j - i (mod BUFFER_SIZE) sits at offset j. Searching from
+            // past it finds nothing, since every byte value is unique.
+            auto value = static_cast<uint8_t>((i + j) % BUFFER_SIZE);
+            ASSERT_EQ(m_ring_buffer.findByte(value), j);
+            ASSERT_EQ(m_ring_buffer.findByte(value, j), j);
+            ASSERT_EQ(m_ring_buffer.findByte(value, j + 1),
+                      RingBuffer::NOT_FOUND);
+        }
+        ASSERT_EQ(m_ring_buffer.findByte(0xff), RingBuffer::NOT_FOUND);
+        ASSERT_EQ(m_ring_buffer.findByte(0, BUFFER_SIZE + 1),
+                  RingBuffer::NOT_FOUND);
+    }
+    m_ring_buffer.clear();
+    ASSERT_EQ(m_ring_buffer.findByte(0), RingBuffer::NOT_FOUND);
+}
+
+TEST_F(RingBufferTest, TestFindBytes) {
+    // Fill the ring buffer so that the data wraps around at offset
+    // BUFFER_SIZE - SHIFT. Offset k then holds m_write_buffer[SHIFT + k]
+    // (mod BUFFER_SIZE).
+    const size_t SHIFT = BUFFER_SIZE / 2;
+    auto at = [&](size_t k) -> int8_t & {
+        return m_write_buffer[(SHIFT + k) % BUFFER_SIZE];
+    };
+    for (auto k = ZERO_SIZE; k + 1 < BUFFER_SIZE; ++k) {
+        // A CRLF at offset k, preceded by a lone CR.
+        fill(m_write_buffer.begin(), m_write_buffer.end(), 'a');
+        at(k) = '\r';
+        at(k + 1) = '\n';
+        if (k > 1) {
+            at(k - 2) = '\r';
+        }
+        m_ring_buffer.clear();
+        testWrite(BUFFER_SIZE, BUFFER_SIZE);
+        testDiscard(SHIFT, SHIFT);
+        testWrite(SHIFT, SHIFT);
+
+        ASSERT_EQ(m_ring_buffer.findBytes("\r\n", 2), k);
+        ASSERT_EQ(m_ring_buffer.findBytes("\r\n", 2, k), k);
+        ASSERT_EQ(m_ring_buffer.findBytes("\r\n", 2, k + 1),
+                  RingBuffer::NOT_FOUND);
+        ASSERT_EQ(m_ring_buffer.findBytes("\n", 1), k + 1);
+        ASSERT_EQ(m_ring_buffer.findBytes("\r\na", 3),
+                  k + 2 < BUFFER_SIZE ? k : RingBuffer::NOT_FOUND);
+    }
+}
+
+TEST(RingBufferSearchTest, TestLongSearch) {
+    // Long enough to exercise the vector kernels' main loops and tails.
+    vector<char> buffer(1000);
+    RingBuffer ring_buffer(buffer.data(), buffer.size());
+    vector<char> data(buffer.size(), 'a');
+    for (size_t i = 0; i < data.size(); i += 37) {
+        fill(data.begin(), data.end(), 'a');
+        data[i] = 'b';
+        ring_buffer.clear();
+        ASSERT_EQ(ring_buffer.writeBytes(data.data(), data.size()),
+                  data.size());
+        ASSERT_EQ(ring_buffer.findByte('b'), i);
+        ASSERT_EQ(ring_buffer.findByte('b', i + 1), RingBuffer::NOT_FOUND);
+        ASSERT_EQ(ring_buffer.findBytes("ab", 2),
+                  i == 0 ? RingBuffer::NOT_FOUND : i - 1);
+    }
+}
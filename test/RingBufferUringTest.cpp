@@ -0,0 +1,162 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "RingBufferUring.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <numeric>
+
+#include <unistd.h>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class RingBufferUringTest : public testing::Test {
+protected:
+    RingBufferUringTest()
+        : m_ring_buffer(m_buffer.data(), BUFFER_SIZE),
+          m_uring(m_ring_buffer, m_buffer.data(), BUFFER_SIZE) {
+        iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+    }
+
+    void SetUp() override {
+        if (!m_uring.isValid()) {
+            GTEST_SKIP() << "io_uring is not available";
+        }
+        ASSERT_EQ(pipe(m_fds.data()), 0);
+    }
+
+    ~RingBufferUringTest() override {
+        for (auto fd : m_fds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+    }
+
+    /**
+     * Leaves 60 readable bytes, 10 to 69 of the write buffer, in the middle
+     * of the ring buffer, so that the free space wraps around.
+     */
+    void wrapFreeSpace() {
+        ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), 70), 70u);
+        ASSERT_EQ(m_ring_buffer.discardBytes(10), 10u);
+        ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 0), 0u);
+        auto free_spans = m_ring_buffer.reserveWrite(BUFFER_SIZE);
+        ASSERT_EQ(free_spans.first.size, 26u);
+        ASSERT_EQ(free_spans.second.size, 10u);
+    }
+
+    void writeToPipe(size_t offset, size_t count) {
+        ASSERT_EQ(write(m_fds[1], m_write_buffer.data() + offset, count),
+                  static_cast<ssize_t>(count));
+    }
+
+    static const size_t BUFFER_SIZE = 96;
+
+    array<int, 2> m_fds = {{-1, -1}};
+    array<int8_t, BUFFER_SIZE> m_read_buffer;
+    array<int8_t, BUFFER_SIZE> m_write_buffer;
+    array<int8_t, BUFFER_SIZE> m_buffer;
+    RingBuffer m_ring_buffer;
+    RingBufferUring m_uring;
+};
+
+const size_t RingBufferUringTest::BUFFER_SIZE;
+
+TEST_F(RingBufferUringTest, ReadFillsWrappedFreeSpace) {
+    wrapFreeSpace();
+    writeToPipe(0, 30);
+
+    ASSERT_TRUE(m_uring.prepareRead(m_fds[0], BUFFER_SIZE));
+    ASSERT_TRUE(m_uring.isReadPending());
+    ASSERT_FALSE(m_uring.prepareRead(m_fds[0], BUFFER_SIZE));
+    ASSERT_EQ(m_uring.submit(true), 1);
+    ASSERT_FALSE(m_uring.isReadPending());
+    ASSERT_EQ(m_uring.getReadResult(), 30);
+
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), BUFFER_SIZE), 90u);
+    ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.begin() + 60,
+                      m_write_buffer.begin() + 10));
+    ASSERT_TRUE(equal(m_read_buffer.begin() + 60, m_read_buffer.begin() + 90,
+                      m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferUringTest, WriteDrainsWrappedData) {
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), BUFFER_SIZE),
+              BUFFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.discardBytes(60), 60u);
+    ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), 30), 30u);
+    ASSERT_FALSE(m_ring_buffer.isContiguous());
+
+    ASSERT_FALSE(m_uring.prepareRead(m_fds[0], 0));
+    ASSERT_TRUE(m_uring.prepareWrite(m_fds[1], BUFFER_SIZE));
+    ASSERT_EQ(m_uring.submit(true), 1);
+    ASSERT_EQ(m_uring.getWriteResult(), 66);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+    ASSERT_FALSE(m_uring.prepareWrite(m_fds[1], BUFFER_SIZE));
+
+    ASSERT_EQ(read(m_fds[0], m_read_buffer.data(), BUFFER_SIZE), 66);
+    ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.begin() + 36,
+                      m_write_buffer.begin() + 60));
+    ASSERT_TRUE(equal(m_read_buffer.begin() + 36, m_read_buffer.begin() + 66,
+                      m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferUringTest, ReadSurvivesConsumerEmptyingRingBuffer) {
+    wrapFreeSpace();
+    ASSERT_TRUE(m_uring.prepareRead(m_fds[0], BUFFER_SIZE));
+    ASSERT_EQ(m_uring.submit(), 0);
+
+    // Emptying the ring buffer rewinds it while the read is in flight.
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), BUFFER_SIZE), 60u);
+    writeToPipe(0, 30);
+    ASSERT_EQ(m_uring.submit(true), 1);
+    ASSERT_EQ(m_uring.getReadResult(), 30);
+
+    auto spans = m_ring_buffer.readableSpans();
+    ASSERT_EQ(spans.first.size, 30u);
+    ASSERT_EQ(spans.second.size, 0u);
+    ASSERT_TRUE(
+        equal(spans.first.data, spans.first.data + 30, m_write_buffer.begin()));
+}
+
+TEST_F(RingBufferUringTest, ReportsEndOfFileAndErrors) {
+    close(m_fds[1]);
+    m_fds[1] = -1;
+    ASSERT_TRUE(m_uring.prepareRead(m_fds[0], BUFFER_SIZE));
+    ASSERT_EQ(m_uring.submit(true), 1);
+    ASSERT_EQ(m_uring.getReadResult(), 0);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+
+    ASSERT_TRUE(m_uring.prepareRead(-1, BUFFER_SIZE));
+    ASSERT_EQ(m_uring.submit(true), 1);
+    ASSERT_EQ(m_uring.getReadResult(), -EBADF);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
@@ -0,0 +1,209 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ShardedRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class ShardedRingBufferTest : public testing::Test {
+protected:
+    static const size_t SHARD_COUNT = 3;
+    static const size_t SHARD_SIZE = 256;
+
+    ShardedRingBufferTest()
+        : m_memory(ShardedRingBuffer::getArenaSize(SHARD_COUNT, SHARD_SIZE) +
+                   CACHE_LINE_SIZE),
+          m_ring_buffer(alignedArena(),
+                        ShardedRingBuffer::getArenaSize(SHARD_COUNT,
+                                                        SHARD_SIZE),
+                        SHARD_COUNT) {}
+
+    vector<char> m_memory;
+    ShardedRingBuffer m_ring_buffer;
+
+    /**
+     * Returns the first cache-line-aligned byte of m_memory.
+     */
+    void *alignedArena() {
+        auto address = reinterpret_cast<uintptr_t>(m_memory.data());
+        auto offset = (CACHE_LINE_SIZE - address % CACHE_LINE_SIZE) %
+                      CACHE_LINE_SIZE;
+        return m_memory.data() + offset;
+    }
+
+    void write(size_t shard, char tag, size_t size, uint64_t sequence = 0) {
+        vector<char> message(size, tag);
+        ASSERT_TRUE(m_ring_buffer.writeMessage(shard, message.data(), size,
+                                               sequence));
+    }
+
+    void read(char tag, size_t expected_size,
+              ShardedRingBuffer::Order order =
+                  ShardedRingBuffer::Order::ROUND_ROBIN) {
+        char message[SHARD_SIZE];
+        size_t size = 0;
+        ASSERT_TRUE(
+            m_ring_buffer.readMessage(message, sizeof(message), size, order));
+        ASSERT_EQ(size, expected_size);
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(message[i], tag);
+        }
+    }
+};
+
+const size_t ShardedRingBufferTest::SHARD_COUNT;
+const size_t ShardedRingBufferTest::SHARD_SIZE;
+
+TEST_F(ShardedRingBufferTest, CarvesShardsFromArena) {
+    ASSERT_EQ(m_ring_buffer.getShardCount(), SHARD_COUNT);
+    ASSERT_EQ(m_ring_buffer.getShardSize(), SHARD_SIZE);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+
+    char message[1];
+    size_t size;
+    ASSERT_FALSE(m_ring_buffer.readMessage(message, sizeof(message), size));
+}
+
+TEST_F(ShardedRingBufferTest, WriteFailsWhenShardIsFull) {
+    auto largest = SHARD_SIZE - ShardedRingBuffer::HEADER_SIZE;
+    write(0, 'a', largest);
+    ASSERT_FALSE(m_ring_buffer.writeMessage(0, "b", 1));
+    vector<char> too_large(largest + 1);
+    ASSERT_FALSE(
+        m_ring_buffer.writeMessage(1, too_large.data(), too_large.size()));
+    // Other shards are unaffected.
+    write(1, 'c', 0);
+    read('a', largest);
+    read('c', 0);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST_F(ShardedRingBufferTest, TooLargeMessageStays) {
+    write(2, 'a', 10);
+    char message[4];
+    size_t size = 0;
+    ASSERT_FALSE(m_ring_buffer.readMessage(message, sizeof(message), size));
+    ASSERT_EQ(size, 10u);
+    ASSERT_FALSE(m_ring_buffer.isEmpty());
+    read('a', 10);
+}
+
+TEST_F(ShardedRingBufferTest, RoundRobinTakesTurns) {
+    write(0, 'a', 1);
+    write(0, 'b', 2);
+    write(1, 'c', 3);
+    write(2, 'd', 4);
+    write(2, 'e', 5);
+    read('a', 1);
+    read('c', 3);
+    read('d', 4);
+    read('b', 2);
+    read('e', 5);
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST_F(ShardedRingBufferTest, FullestIsDrainedFirst) {
+    auto fullest = ShardedRingBuffer::Order::FULLEST;
+    write(0, 'a', 10);
+    write(1, 'b', 60);
+    write(2, 'c', 20);
+    write(2, 'd', 20);
+    read('b', 60, fullest);
+    read('c', 20, fullest);
+    read('d', 20, fullest);
+    read('a', 10, fullest);
+}
+
+TEST_F(ShardedRingBufferTest, OldestMergesBySequence) {
+    auto oldest = ShardedRingBuffer::Order::OLDEST;
+    write(0, 'a', 1, 10);
+    write(0, 'd', 1, 40);
+    write(1, 'b', 1, 20);
+    write(2, 'c', 1, 30);
+    write(2, 'e', 1, 50);
+    for (auto tag : {'a', 'b', 'c', 'd', 'e'}) {
+        read(tag, 1, oldest);
+    }
+    ASSERT_TRUE(m_ring_buffer.isEmpty());
+}
+
+TEST(ShardedRingBufferThreadTest, ProducersFanIn) {
+    const size_t producers = 4;
+    const uint64_t messages = 20000;
+    vector<char> memory(ShardedRingBuffer::getArenaSize(producers, 1024) +
+                        CACHE_LINE_SIZE);
+    auto address = reinterpret_cast<uintptr_t>(memory.data());
+    auto arena =
+        memory.data() +
+        (CACHE_LINE_SIZE - address % CACHE_LINE_SIZE) % CACHE_LINE_SIZE;
+    ShardedRingBuffer ring_buffer(
+        arena, ShardedRingBuffer::getArenaSize(producers, 1024), producers);
+
+    vector<thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&ring_buffer, p, messages] {
+            for (uint64_t i = 0; i < messages; ++i) {
+                const uint64_t message[] = {p, i};
+                while (!ring_buffer.writeMessage(p, message, sizeof(message),
+                                                 i)) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's messages arrive in order, whichever shard is drained.
+    vector<uint64_t> next(producers, 0);
+    const ShardedRingBuffer::Order orders[] = {
+        ShardedRingBuffer::Order::ROUND_ROBIN,
+        ShardedRingBuffer::Order::FULLEST, ShardedRingBuffer::Order::OLDEST};
+    uint64_t received = 0;
+    bool ordered = true;
+    while (received < producers * messages) {
+        uint64_t message[2];
+        size_t size;
+        if (!ring_buffer.readMessage(message, sizeof(message), size,
+                                     orders[received % 3])) {
+            this_thread::yield();
+            continue;
+        }
+        ordered = ordered && size == sizeof(message) &&
+                  message[0] < producers && message[1] == next[message[0]]++;
+        ++received;
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    ASSERT_TRUE(ordered);
+    ASSERT_TRUE(ring_buffer.isEmpty());
+}
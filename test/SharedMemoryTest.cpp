@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "SharedMemory.h"
+#include "SharedRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+/**
+ * Returns a name that no other test run uses.
+ */
+string uniqueName(const char *suffix) {
+#if defined(__unix__) || defined(__APPLE__)
+    auto pid = static_cast<long>(getpid());
+#else
+    long pid = 0;
+#endif
+    return "/hdc-ringbuffer-test-" + to_string(pid) + "-" + suffix;
+}
+
+} // namespace
+
+TEST(SharedMemoryTest, OpenSeesCreatedMemory) {
+    auto name = uniqueName("open");
+    SharedMemory created(name.c_str(), 4096);
+    ASSERT_TRUE(created.isValid());
+    ASSERT_EQ(created.getSize(), 4096u);
+    static_cast<char *>(created.getBuffer())[100] = 'x';
+
+    SharedMemory opened(name.c_str());
+    ASSERT_TRUE(opened.isValid());
+    ASSERT_GE(opened.getSize(), 4096u);
+    ASSERT_EQ(static_cast<char *>(opened.getBuffer())[100], 'x');
+
+    // A name can only be created once.
+    SharedMemory duplicate(name.c_str(), 4096);
+    ASSERT_FALSE(duplicate.isValid());
+
+    ASSERT_TRUE(SharedMemory::remove(name.c_str()));
+}
+
+TEST(SharedMemoryTest, OpenMissingIsInvalid) {
+    SharedMemory memory(uniqueName("missing").c_str());
+    ASSERT_FALSE(memory.isValid());
+    ASSERT_EQ(memory.getBuffer(), nullptr);
+    ASSERT_EQ(memory.getSize(), 0u);
+}
+
+TEST(SharedMemoryTest, MoveTransfersMapping) {
+    auto name = uniqueName("move");
+    SharedMemory memory(name.c_str(), 4096);
+    ASSERT_TRUE(memory.isValid());
+    auto buffer = memory.getBuffer();
+
+    SharedMemory other(move(memory));
+    ASSERT_FALSE(memory.isValid());
+    ASSERT_EQ(other.getBuffer(), buffer);
+
+    memory = move(other);
+    ASSERT_TRUE(memory.isValid());
+    ASSERT_FALSE(other.isValid());
+    ASSERT_EQ(memory.getBuffer(), buffer);
+    SharedMemory::remove(name.c_str());
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST(SharedMemoryTest, RingBufferCrossesProcesses) {
+    const size_t total = 1 << 20;
+    auto name = uniqueName("ring");
+    SharedMemory created(name.c_str(), SharedRingBuffer::getMemorySize(4096));
+    ASSERT_TRUE(created.isValid());
+    SharedRingBuffer::initialize(created.getBuffer(), created.getSize());
+
+    auto child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        // The producer opens the memory by name, as an unrelated process
+        // would, and writes a known sequence.
+        SharedMemory opened(name.c_str());
+        SharedRingBuffer producer(opened.getBuffer(), opened.getSize());
+        if (!producer.isValid()) {
+            _exit(1);
+        }
+        unsigned char chunk[100];
+        size_t sent = 0;
+        while (sent < total) {
+            auto n = min(sizeof(chunk), total - sent);
+            for (size_t i = 0; i < n; ++i) {
+                chunk[i] = static_cast<unsigned char>((sent + i) % 251);
+            }
+            size_t written = 0;
+            while (written < n) {
+                written += producer.writeBytes(chunk + written, n - written);
+            }
+            sent += n;
+        }
+        _exit(0);
+    }
+
+    SharedRingBuffer consumer(created.getBuffer(), created.getSize());
+    ASSERT_TRUE(consumer.isValid());
+    unsigned char chunk[64];
+    size_t received = 0;
+    bool ok = true;
+    int status;
+    bool exited = false;
+    while (received < total) {
+        auto n = consumer.readBytes(chunk, sizeof(chunk));
+        for (size_t i = 0; i < n; ++i) {
+            ok = ok && chunk[i] == (received + i) % 251;
+        }
+        received += n;
+        // Don't wait forever for a producer that failed, but drain what it
+        // wrote before it exited.
+        if (n == 0) {
+            if (exited) {
+                break;
+            }
+            exited = waitpid(child, &status, WNOHANG) == child;
+        }
+    }
+    if (!exited) {
+        ASSERT_EQ(waitpid(child, &status, 0), child);
+    }
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    ASSERT_EQ(received, total);
+    ASSERT_TRUE(ok);
+    ASSERT_TRUE(SharedMemory::remove(name.c_str()));
+}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "SharedRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+class SharedRingBufferTest : public testing::Test {
+protected:
+    static const size_t CAPACITY = 96;
+
+    SharedRingBufferTest() : m_memory() {
+        SharedRingBuffer::initialize(m_memory.data(), MEMORY_SIZE);
+    }
+
+    static const size_t MEMORY_SIZE =
+        SharedRingBuffer::getMemorySize(CAPACITY);
+
+    alignas(128) array<char, MEMORY_SIZE> m_memory;
+    array<char, CAPACITY> m_write_buffer;
+    array<char, CAPACITY> m_read_buffer;
+};
+
+const size_t SharedRingBufferTest::CAPACITY;
+const size_t SharedRingBufferTest::MEMORY_SIZE;
+
+TEST_F(SharedRingBufferTest, InitializeUsesRestOfMemory) {
+    ASSERT_EQ(SharedRingBuffer::getMemorySize(CAPACITY), MEMORY_SIZE);
+    SharedRingBuffer ring_buffer(m_memory.data(), MEMORY_SIZE);
+    ASSERT_TRUE(ring_buffer.isValid());
+    ASSERT_EQ(ring_buffer.getCapacity(), CAPACITY);
+    ASSERT_TRUE(ring_buffer.isEmpty());
+    ASSERT_EQ(ring_buffer.getWritableByteCount(), CAPACITY);
+}
+
+TEST_F(SharedRingBufferTest, RejectsBadMemory) {
+    // Too small for the capacity recorded in the control block.
+    SharedRingBuffer small(m_memory.data(), MEMORY_SIZE - 1);
+    ASSERT_FALSE(small.isValid());
+
+    // Not formatted.
+    alignas(128) array<char, MEMORY_SIZE> blank = {};
+    SharedRingBuffer unformatted(blank.data(), blank.size());
+    ASSERT_FALSE(unformatted.isValid());
+
+    // A different layout version.
+    copy(m_memory.begin(), m_memory.end(), blank.begin());
+    blank[4] ^= 1;
+    SharedRingBuffer other_version(blank.data(), blank.size());
+    ASSERT_FALSE(other_version.isValid());
+}
+
+TEST_F(SharedRingBufferTest, SidesShareState) {
+    // The producer and the consumer attach separately, as two processes
+    // would.
+    SharedRingBuffer producer(m_memory.data(), MEMORY_SIZE);
+    SharedRingBuffer consumer(m_memory.data(), MEMORY_SIZE);
+    ASSERT_TRUE(producer.isValid());
+    ASSERT_TRUE(consumer.isValid());
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+
+    for (size_t i = 0; i <= CAPACITY; ++i) {
+        // Move the indexes along so that the data wraps around.
+        ASSERT_EQ(producer.writeBytes(m_write_buffer.data(), i), i);
+        ASSERT_EQ(consumer.discardBytes(i), i);
+
+        ASSERT_EQ(producer.writeBytes(m_write_buffer.data(), CAPACITY + 1),
+                  CAPACITY);
+        ASSERT_TRUE(consumer.isFull());
+        ASSERT_EQ(consumer.peekBytes(m_read_buffer.data(), 10), 10u);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.begin() + 10,
+                          m_write_buffer.begin()));
+
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+        ASSERT_EQ(consumer.readBytes(m_read_buffer.data(), CAPACITY + 1),
+                  CAPACITY);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_write_buffer.begin()));
+        ASSERT_TRUE(producer.isEmpty());
+        ASSERT_EQ(consumer.readBytes(m_read_buffer.data(), 1), 0u);
+    }
+}
+
+TEST_F(SharedRingBufferTest, AttachSeesExistingData) {
+    SharedRingBuffer producer(m_memory.data(), MEMORY_SIZE);
+    const char message[] = "hello";
+    ASSERT_EQ(producer.writeBytes(message, sizeof(message)), sizeof(message));
+
+    SharedRingBuffer consumer(m_memory.data(), MEMORY_SIZE);
+    ASSERT_TRUE(consumer.isValid());
+    ASSERT_EQ(consumer.getReadableByteCount(), sizeof(message));
+    char received[sizeof(message)];
+    ASSERT_EQ(consumer.readBytes(received, sizeof(received)), sizeof(message));
+    ASSERT_STREQ(received, message);
+}
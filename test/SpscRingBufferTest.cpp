@@ -0,0 +1,448 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "SpscRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+size_t emptyCopyCount;
+
+void countingCopy(void *destination, const void *source, size_t count) {
+    if (count == 0) {
+        ++emptyCopyCount;
+    }
+    memcpy(destination, source, count);
+}
+
+} // namespace
+
+class SpscRingBufferTest : public testing::Test {
+protected:
+    SpscRingBufferTest() : m_ring_buffer(m_buffer.data(), BUFFER_SIZE) {}
+
+    static const size_t ZERO_SIZE = 0;
+    static const size_t BUFFER_SIZE = 96;
+    static const size_t EXTRA_BUFFER_SIZE = 3;
+
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_check_buffer;
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_read_buffer;
+    array<int8_t, BUFFER_SIZE + EXTRA_BUFFER_SIZE> m_write_buffer;
+    array<int8_t, BUFFER_SIZE> m_buffer;
+    SpscRingBuffer m_ring_buffer;
+
+    void checkState(bool empty, bool full, size_t readable_count,
+                    size_t writable_count) const {
+        ASSERT_EQ(m_ring_buffer.isEmpty(), empty);
+        ASSERT_EQ(m_ring_buffer.isFull(), full);
+        ASSERT_EQ(m_ring_buffer.getReadableByteCount(), readable_count);
+        ASSERT_EQ(m_ring_buffer.getWritableByteCount(), writable_count);
+    }
+
+    void testRead(size_t requested, size_t expected) {
+        ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), requested),
+                  expected);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+    }
+
+    void testWrite(size_t requested, size_t expected) {
+        ASSERT_EQ(m_ring_buffer.writeBytes(m_write_buffer.data(), requested),
+                  expected);
+    }
+
+    void testPeekAt(size_t requested, size_t where, size_t expected) {
+        ASSERT_EQ(
+            m_ring_buffer.peekBytesAt(m_read_buffer.data(), requested, where),
+            expected);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+    }
+};
+
+const size_t SpscRingBufferTest::ZERO_SIZE;
+const size_t SpscRingBufferTest::BUFFER_SIZE;
+const size_t SpscRingBufferTest::EXTRA_BUFFER_SIZE;
+
+TEST_F(SpscRingBufferTest, IsCacheLineAligned) {
+    ASSERT_GE(alignof(SpscRingBuffer), CACHE_LINE_SIZE);
+    ASSERT_GE(sizeof(SpscRingBuffer), 3 * CACHE_LINE_SIZE);
+}
+
+TEST_F(SpscRingBufferTest, IsInitiallyEmpty) {
+    checkState(true, false, 0, BUFFER_SIZE);
+}
+
+TEST_F(SpscRingBufferTest, TestWriteReadClear) {
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Write up to i items to the ring buffer.
+            auto expected_write = min(i, BUFFER_SIZE);
+            iota(m_write_buffer.begin(), m_write_buffer.begin() + i, 0);
+            testWrite(i, expected_write);
+            checkState(expected_write == ZERO_SIZE,
+                       expected_write == BUFFER_SIZE, expected_write,
+                       BUFFER_SIZE - expected_write);
+
+            // Read up to j items from the ring buffer.
+            auto expected_read = min(j, expected_write);
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + expected_read,
+                 0);
+            fill(m_check_buffer.begin() + expected_read, m_check_buffer.end(),
+                 -1);
+            testRead(j, expected_read);
+            checkState(expected_write - expected_read == ZERO_SIZE,
+                       expected_write - expected_read == BUFFER_SIZE,
+                       expected_write - expected_read,
+                       BUFFER_SIZE - expected_write + expected_read);
+
+            // Clear the ring buffer for next iteration. This leaves the
+            // indices where they are, so later iterations also exercise
+            // wrapping.
+            m_ring_buffer.clear();
+            checkState(true, false, ZERO_SIZE, BUFFER_SIZE);
+        }
+    }
+}
+
+TEST_F(SpscRingBufferTest, TestDiscardPeekAt) {
+    for (auto i = ZERO_SIZE; i < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++i) {
+        for (auto j = ZERO_SIZE; j < BUFFER_SIZE + EXTRA_BUFFER_SIZE; ++j) {
+            // Write up to i items to the ring buffer.
+            auto expected_write = min(i, BUFFER_SIZE);
+            iota(m_write_buffer.begin(), m_write_buffer.begin() + i, 0);
+            testWrite(i, expected_write);
+
+            // Peek up to j items from the ring buffer at end of the buffer.
+            auto expected_peek = min(j, expected_write);
+            auto where = j < expected_write ? expected_write - j : ZERO_SIZE;
+            fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+            iota(m_check_buffer.begin(), m_check_buffer.begin() + expected_peek,
+                 static_cast<int8_t>(where));
+            fill(m_check_buffer.begin() + expected_peek, m_check_buffer.end(),
+                 -1);
+            testPeekAt(j, where, expected_peek);
+            checkState(expected_write == ZERO_SIZE,
+                       expected_write == BUFFER_SIZE, expected_write,
+                       BUFFER_SIZE - expected_write);
+
+            // Discard up to j items from the ring buffer.
+            auto expected_discard = min(j, expected_write);
+            ASSERT_EQ(m_ring_buffer.discardBytes(j), expected_discard);
+            checkState(expected_write - expected_discard == ZERO_SIZE,
+                       expected_write - expected_discard == BUFFER_SIZE,
+                       expected_write - expected_discard,
+                       BUFFER_SIZE - expected_write + expected_discard);
+
+            m_ring_buffer.clear();
+        }
+    }
+}
+
+TEST_F(SpscRingBufferTest, TestProducerConsumer) {
+    // Stream a long pattern through the ring buffer from one thread to another
+    // in chunks of varying sizes and check that it arrives intact.
+    static const size_t TOTAL_SIZE = 1 << 18;
+
+    thread producer([this] {
+        array<uint8_t, BUFFER_SIZE> chunk;
+        size_t sent = 0;
+        size_t chunk_size = 1;
+        while (sent < TOTAL_SIZE) {
+            auto n = min(chunk_size, TOTAL_SIZE - sent);
+            for (size_t k = 0; k < n; ++k) {
+                chunk[k] = static_cast<uint8_t>(sent + k);
+            }
+            size_t written = 0;
+            while (written < n) {
+                auto count = m_ring_buffer.writeBytes(chunk.data() + written,
+                                                      n - written);
+                if (count == 0) {
+                    this_thread::yield();
+                }
+                written += count;
+            }
+            sent += n;
+            chunk_size = chunk_size % BUFFER_SIZE + 1;
+        }
+    });
+
+    array<uint8_t, BUFFER_SIZE> chunk;
+    size_t received = 0;
+    size_t chunk_size = BUFFER_SIZE;
+    bool intact = true;
+    while (received < TOTAL_SIZE) {
+        auto n = m_ring_buffer.readBytes(chunk.data(), chunk_size);
+        if (n == 0) {
+            this_thread::yield();
+        }
+        for (size_t k = 0; k < n; ++k) {
+            intact = intact && chunk[k] == static_cast<uint8_t>(received + k);
+        }
+        received += n;
+        chunk_size = chunk_size > 1 ? chunk_size - 1 : BUFFER_SIZE;
+    }
+
+    producer.join();
+    ASSERT_TRUE(intact);
+    checkState(true, false, 0, BUFFER_SIZE);
+}
+
+TEST_F(SpscRingBufferTest, WaitTimesOut) {
+    // Nothing to read: waits for the timeout, then reads nothing.
+    auto start = chrono::steady_clock::now();
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(), 1,
+                                          chrono::milliseconds(20)),
+              0u);
+    ASSERT_GE(chrono::steady_clock::now() - start, chrono::milliseconds(20));
+
+    // Only part of the requested bytes: waits, then reads what is there.
+    testWrite(3, 3);
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(), 5,
+                                          chrono::milliseconds(1)),
+              3u);
+
+    // No room to write: waits for the timeout, then writes what fits.
+    testWrite(BUFFER_SIZE - 1, BUFFER_SIZE - 1);
+    start = chrono::steady_clock::now();
+    ASSERT_EQ(m_ring_buffer.writeBytesWait(m_write_buffer.data(), 2,
+                                           chrono::milliseconds(20)),
+              1u);
+    ASSERT_GE(chrono::steady_clock::now() - start, chrono::milliseconds(20));
+    checkState(false, true, BUFFER_SIZE, 0);
+}
+
+TEST_F(SpscRingBufferTest, WaitReturnsWhenReady) {
+    // Already satisfied: does not wait at all.
+    testWrite(10, 10);
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(), 10,
+                                          chrono::hours(1)),
+              10u);
+
+    // A request larger than the ring buffer waits for a full ring buffer.
+    testWrite(BUFFER_SIZE, BUFFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(),
+                                          BUFFER_SIZE + 1, chrono::hours(1)),
+              BUFFER_SIZE);
+    ASSERT_EQ(m_ring_buffer.writeBytesWait(m_write_buffer.data(),
+                                           BUFFER_SIZE + 1, chrono::hours(1)),
+              BUFFER_SIZE);
+}
+
+TEST_F(SpscRingBufferTest, WaitIsWoken) {
+    // The consumer goes to sleep well before the producer writes, and the
+    // producer's write wakes it long before its timeout.
+    thread producer([this] {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        testWrite(4, 4);
+    });
+    auto start = chrono::steady_clock::now();
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(), 4,
+                                          chrono::seconds(30)),
+              4u);
+    ASSERT_LT(chrono::steady_clock::now() - start, chrono::seconds(10));
+    producer.join();
+
+    // Likewise for a producer waiting for space.
+    testWrite(BUFFER_SIZE, BUFFER_SIZE);
+    thread consumer([this] {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        ASSERT_EQ(m_ring_buffer.discardBytes(4), 4u);
+    });
+    start = chrono::steady_clock::now();
+    ASSERT_EQ(m_ring_buffer.writeBytesWait(m_write_buffer.data(), 4,
+                                           chrono::seconds(30)),
+              4u);
+    ASSERT_LT(chrono::steady_clock::now() - start, chrono::seconds(10));
+    consumer.join();
+}
+
+TEST_F(SpscRingBufferTest, WaitsForeverWithMaxTimeout) {
+    // The largest timeout must not overflow the deadline into the past.
+    thread producer([this] {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        testWrite(4, 4);
+    });
+    ASSERT_EQ(m_ring_buffer.readBytesWait(m_read_buffer.data(), 4,
+                                          chrono::nanoseconds::max()),
+              4u);
+    producer.join();
+}
+
+TEST_F(SpscRingBufferTest, TestProducerConsumerWait) {
+    // Stream a pattern through the ring buffer with both sides waiting
+    // instead of polling, and check that it arrives intact.
+    static const size_t TOTAL_SIZE = 1 << 16;
+
+    thread producer([this] {
+        array<uint8_t, 7> chunk;
+        for (size_t sent = 0; sent < TOTAL_SIZE;) {
+            auto n = min(chunk.size(), TOTAL_SIZE - sent);
+            for (size_t k = 0; k < n; ++k) {
+                chunk[k] = static_cast<uint8_t>(sent + k);
+            }
+            size_t written = 0;
+            while (written < n) {
+                written += m_ring_buffer.writeBytesWait(
+                    chunk.data() + written, n - written, chrono::seconds(1));
+            }
+            sent += n;
+        }
+    });
+
+    array<uint8_t, 11> chunk;
+    size_t received = 0;
+    bool intact = true;
+    while (received < TOTAL_SIZE) {
+        auto n = m_ring_buffer.readBytesWait(
+            chunk.data(), min(chunk.size(), TOTAL_SIZE - received),
+            chrono::seconds(1));
+        for (size_t k = 0; k < n; ++k) {
+            intact = intact && chunk[k] == static_cast<uint8_t>(received + k);
+        }
+        received += n;
+    }
+
+    producer.join();
+    ASSERT_TRUE(intact);
+    checkState(true, false, 0, BUFFER_SIZE);
+}
+
+TEST_F(SpscRingBufferTest, TestBatch) {
+    const size_t sizes[] = {5, 17, 40, 30, 10};
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        // Move the read and write locations to i so that the batch wraps
+        // around.
+        m_ring_buffer.clear();
+        testWrite(i, i);
+        ASSERT_EQ(m_ring_buffer.discardBytes(i), i);
+
+        // All but the last message fit.
+        ConstSpan messages[5];
+        auto source = reinterpret_cast<const char *>(m_write_buffer.data());
+        for (size_t k = 0; k < 5; ++k) {
+            messages[k].data = source;
+            messages[k].size = sizes[k];
+            source += sizes[k];
+        }
+        ASSERT_EQ(m_ring_buffer.writeBatch(messages, 5), 4u);
+        checkState(false, false, 92, BUFFER_SIZE - 92);
+
+        // All but the last destination fill up.
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+        Span destinations[5];
+        auto destination = reinterpret_cast<char *>(m_read_buffer.data());
+        for (size_t k = 0; k < 5; ++k) {
+            destinations[k].data = destination;
+            destinations[k].size = k == 4 ? 3 : sizes[k];
+            destination += sizes[k];
+        }
+        ASSERT_EQ(m_ring_buffer.readBatch(destinations, 5), 4u);
+        iota(m_check_buffer.begin(), m_check_buffer.begin() + 92, 0);
+        fill(m_check_buffer.begin() + 92, m_check_buffer.end(), -1);
+        ASSERT_TRUE(equal(m_read_buffer.begin(), m_read_buffer.end(),
+                          m_check_buffer.begin(), m_check_buffer.end()));
+        checkState(true, false, 0, BUFFER_SIZE);
+
+        // Nothing to do.
+        ASSERT_EQ(m_ring_buffer.writeBatch(messages, 0), 0u);
+        ASSERT_EQ(m_ring_buffer.readBatch(destinations, 1), 0u);
+    }
+}
+
+TEST_F(SpscRingBufferTest, TestNonTemporalCopy) {
+    m_ring_buffer.setCopyFunction(nonTemporalCopy);
+    ASSERT_EQ(m_ring_buffer.getCopyFunction(), nonTemporalCopy);
+    iota(m_write_buffer.begin(), m_write_buffer.end(), 0);
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        // Move the read and write locations to i so that the data wraps
+        // around.
+        m_ring_buffer.clear();
+        testWrite(i, i);
+        ASSERT_EQ(m_ring_buffer.discardBytes(i), i);
+
+        testWrite(80, 80);
+        fill(m_read_buffer.begin(), m_read_buffer.end(), -1);
+        iota(m_check_buffer.begin(), m_check_buffer.begin() + 80, 0);
+        fill(m_check_buffer.begin() + 80, m_check_buffer.end(), -1);
+        testRead(80, 80);
+        checkState(true, false, 0, BUFFER_SIZE);
+    }
+}
+
+TEST_F(SpscRingBufferTest, CopyFunctionSeesNoEmptyCopies) {
+    m_ring_buffer.setCopyFunction(countingCopy);
+    emptyCopyCount = 0;
+    for (auto i = ZERO_SIZE; i <= BUFFER_SIZE; ++i) {
+        // Transfers that end exactly at the end of the buffer have nothing
+        // left to copy to or from its beginning.
+        m_ring_buffer.clear();
+        testWrite(i, i);
+        ASSERT_EQ(m_ring_buffer.discardBytes(i), i);
+        testWrite(BUFFER_SIZE - i, BUFFER_SIZE - i);
+        ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), BUFFER_SIZE),
+                  BUFFER_SIZE - i);
+        testWrite(20, 20);
+        ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 20), 20u);
+    }
+    ASSERT_EQ(emptyCopyCount, 0u);
+}
+
+TEST_F(SpscRingBufferTest, TestStats) {
+    // Without HDC_RINGBUFFER_STATS, every statistic stays zero.
+    auto expected = [](uint64_t value) {
+        return RingBufferStats::ENABLED ? value : 0;
+    };
+
+    testWrite(60, 60);
+    testWrite(60, BUFFER_SIZE - 60);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 50), 50u);
+    ASSERT_EQ(m_ring_buffer.discardBytes(100), BUFFER_SIZE - 50);
+    ASSERT_EQ(m_ring_buffer.peekBytes(m_read_buffer.data(), 1), 0u);
+    ASSERT_EQ(m_ring_buffer.readBytes(m_read_buffer.data(), 1), 0u);
+    testWrite(10, 10);
+
+    auto stats = m_ring_buffer.getStats();
+    ASSERT_EQ(stats.bytesWritten, expected(BUFFER_SIZE + 10));
+    ASSERT_EQ(stats.bytesRead, expected(BUFFER_SIZE));
+    ASSERT_EQ(stats.shortWrites, expected(1));
+    ASSERT_EQ(stats.shortReads, expected(2));
+    ASSERT_EQ(stats.fullCount, expected(1));
+    ASSERT_EQ(stats.emptyCount, expected(1));
+    ASSERT_EQ(stats.wrapCount, expected(1));
+    ASSERT_EQ(stats.peakReadableBytes, expected(BUFFER_SIZE));
+}
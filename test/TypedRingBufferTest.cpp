@@ -0,0 +1,145 @@
+/*
+MIT License
+
+Copyright (c) 2025 Henry da Costa
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "TypedRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+using namespace std;
+using namespace hdc::ringbuffer;
+
+namespace {
+
+struct Record {
+    uint64_t sequence;
+    uint32_t price;
+    char symbol[4];
+};
+
+Record makeRecord(uint64_t sequence) {
+    Record record = {sequence, static_cast<uint32_t>(sequence * 3),
+                     {'A', 'B', 'C', static_cast<char>('0' + sequence % 10)}};
+    return record;
+}
+
+void checkRecord(const Record &record, uint64_t sequence) {
+    auto expected = makeRecord(sequence);
+    ASSERT_EQ(record.sequence, expected.sequence);
+    ASSERT_EQ(record.price, expected.price);
+    ASSERT_EQ(record.symbol[3], expected.symbol[3]);
+}
+
+} // namespace
+
+class TypedRingBufferTest : public testing::Test {
+protected:
+    TypedRingBufferTest() : m_buffer(), m_ring_buffer(m_buffer) {}
+
+    // Not a power of two, so that wrapping goes through the general path.
+    static const size_t CAPACITY = 7;
+
+    Record m_buffer[CAPACITY];
+    TypedRingBuffer<Record, CAPACITY> m_ring_buffer;
+
+    void checkState(bool empty, bool full, size_t readable_count,
+                    size_t writable_count) const {
+        ASSERT_EQ(m_ring_buffer.isEmpty(), empty);
+        ASSERT_EQ(m_ring_buffer.isFull(), full);
+        ASSERT_EQ(m_ring_buffer.getReadableCount(), readable_count);
+        ASSERT_EQ(m_ring_buffer.getWritableCount(), writable_count);
+    }
+};
+
+const size_t TypedRingBufferTest::CAPACITY;
+
+TEST_F(TypedRingBufferTest, TestInitialState) {
+    ASSERT_EQ((TypedRingBuffer<Record, CAPACITY>::CAPACITY), CAPACITY);
+    checkState(true, false, 0, CAPACITY);
+    Record record;
+    ASSERT_FALSE(m_ring_buffer.read(record));
+    ASSERT_FALSE(m_ring_buffer.peek(record));
+}
+
+TEST_F(TypedRingBufferTest, TestFillAndDrain) {
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        ASSERT_TRUE(m_ring_buffer.write(makeRecord(i)));
+        checkState(false, i + 1 == CAPACITY, i + 1, CAPACITY - i - 1);
+    }
+    ASSERT_FALSE(m_ring_buffer.write(makeRecord(CAPACITY)));
+
+    Record record;
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        ASSERT_TRUE(m_ring_buffer.peek(record));
+        checkRecord(record, i);
+        ASSERT_TRUE(m_ring_buffer.read(record));
+        checkRecord(record, i);
+    }
+    checkState(true, false, 0, CAPACITY);
+    ASSERT_FALSE(m_ring_buffer.read(record));
+}
+
+TEST_F(TypedRingBufferTest, TestWrapAround) {
+    // Keep three records in flight for many laps of the buffer.
+    uint64_t next_write = 0;
+    uint64_t next_read = 0;
+    Record record;
+    for (; next_write < 3; ++next_write) {
+        ASSERT_TRUE(m_ring_buffer.write(makeRecord(next_write)));
+    }
+    for (; next_write < 10 * CAPACITY; ++next_write, ++next_read) {
+        ASSERT_TRUE(m_ring_buffer.write(makeRecord(next_write)));
+        ASSERT_TRUE(m_ring_buffer.read(record));
+        checkRecord(record, next_read);
+        checkState(false, false, 3, CAPACITY - 3);
+    }
+}
+
+TEST_F(TypedRingBufferTest, TestBulk) {
+    Record source[CAPACITY + 2];
+    for (size_t i = 0; i < CAPACITY + 2; ++i) {
+        source[i] = makeRecord(i);
+    }
+    ASSERT_EQ(m_ring_buffer.write(source, 3), 3u);
+    ASSERT_EQ(m_ring_buffer.discard(2), 2u);
+    // Only CAPACITY - 1 records fit, wrapping around the end of the buffer.
+    ASSERT_EQ(m_ring_buffer.write(source + 3, CAPACITY), CAPACITY - 1);
+    checkState(false, true, CAPACITY, 0);
+
+    Record destination[CAPACITY + 2];
+    ASSERT_EQ(m_ring_buffer.read(destination, CAPACITY + 2), CAPACITY);
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        checkRecord(destination[i], i + 2);
+    }
+    checkState(true, false, 0, CAPACITY);
+}
+
+TEST_F(TypedRingBufferTest, TestClear) {
+    ASSERT_TRUE(m_ring_buffer.write(makeRecord(0)));
+    ASSERT_TRUE(m_ring_buffer.write(makeRecord(1)));
+    m_ring_buffer.clear();
+    checkState(true, false, 0, CAPACITY);
+    ASSERT_EQ(m_ring_buffer.discard(1), 0u);
+}